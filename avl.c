@@ -4,8 +4,6 @@
 #include <stdlib.h>
 #include <string.h>
 
-#define INITIAL_OFFSET_CAPACITY 10
-
 // Função para obter a altura de um nó
 static int height(AVLNode *node) {
     return (node == NULL) ? 0 : node->height;
@@ -16,32 +14,23 @@ static int max(int a, int b) {
     return (a > b) ? a : b;
 }
 
-// Cria um novo nó AVL para a palavra
-static AVLNode* createAVLNode(const char *word, long offset) {
-    AVLNode *node = (AVLNode *)malloc(sizeof(AVLNode));
-    if (node == NULL) {
-        fprintf(stderr, "Erro ao alocar memória para AVLNode.\n");
-        exit(EXIT_FAILURE);
-    }
-    node->word = strdup(word);
-    if (node->word == NULL) {
-        fprintf(stderr, "Erro ao alocar memória para a palavra na AVL.\n");
-        exit(EXIT_FAILURE);
-    }
-    node->frequency = 1;
-    node->capacity_offsets = INITIAL_OFFSET_CAPACITY;
-    node->count_offsets = 0;
-    node->offsets = (long *)malloc(INITIAL_OFFSET_CAPACITY * sizeof(long));
-    if (node->offsets == NULL) {
-        fprintf(stderr, "Erro ao alocar memória para offsets na AVL.\n");
-        exit(EXIT_FAILURE);
-    }
-    node->offsets[node->count_offsets++] = offset;
+// Cria um novo nó AVL para a palavra (alocado do pool)
+static AVLNode* createAVLNode(const char *prefix, const char *word, uint32_t doc, TreePool *pool) {
+    AVLNode *node = (AVLNode *)pool_alloc(&pool->nodes, sizeof(AVLNode));
+    memcpy(node->prefix, prefix, KEY_PREFIX_LEN);
+    // Palavras curtas cabem no prefixo e não precisam de cópia separada
+    const char *full = key_is_inline(node->prefix) ? node->prefix : pool_strdup(&pool->postings, word);
+    node->postings = postings_create(&pool->postings, full, doc);
     node->left = node->right = NULL;
     node->height = 1; // Nó folha tem altura 1
     return node;
 }
 
+// Compara a palavra (com prefixo já calculado) com a chave do nó
+static int compareNode(const char *prefix, const char *word, const AVLNode *node) {
+    return key_compare(prefix, word, node->prefix, &node->postings->word);
+}
+
 // Rotação à direita
 static AVLNode* rightRotate(AVLNode *y) {
     AVLNode *x = y->left;
@@ -69,31 +58,22 @@ static int getBalance(AVLNode *node) {
     return (node == NULL) ? 0 : height(node->left) - height(node->right);
 }
 
-// Insere ou atualiza a palavra na AVL
-AVLNode* avl_insert(AVLNode *root, const char *word, long offset) {
+// Insere ou atualiza a palavra na AVL (o prefixo da palavra é calculado uma única vez)
+static AVLNode* insertNode(AVLNode *root, const char *prefix, const char *word, uint32_t doc, TreePool *pool) {
     if (root == NULL)
-        return createAVLNode(word, offset);
+        return createAVLNode(prefix, word, doc, pool);
 
-    int cmp = strcmp(word, root->word);
+    int cmp = compareNode(prefix, word, root);
     if (cmp == 0) {
-        // Palavra já existe: atualiza a frequência e adiciona offset
-        root->frequency++;
-        if (root->count_offsets >= root->capacity_offsets) {
-            root->capacity_offsets *= 2;
-            root->offsets = realloc(root->offsets, root->capacity_offsets * sizeof(long));
-            if (root->offsets == NULL) {
-                fprintf(stderr, "Erro ao realocar memória para offsets na AVL.\n");
-                exit(EXIT_FAILURE);
-            }
-        }
-        root->offsets[root->count_offsets++] = offset;
+        // Palavra já existe: atualiza a frequência e adiciona o documento
+        postings_add(root->postings, doc, &pool->postings);
         return root;
     } else if (cmp < 0) {
         // Se a palavra for menor, insere à esquerda
-        root->left = avl_insert(root->left, word, offset);
+        root->left = insertNode(root->left, prefix, word, doc, pool);
     } else {
         // Se a palavra for maior, insere à direita
-        root->right = avl_insert(root->right, word, offset);
+        root->right = insertNode(root->right, prefix, word, doc, pool);
     }
 
     // Atualiza a altura do nó
@@ -103,21 +83,21 @@ AVLNode* avl_insert(AVLNode *root, const char *word, long offset) {
     int balance = getBalance(root);
 
     // Caso Esquerda-Esquerda
-    if (balance > 1 && strcmp(word, root->left->word) < 0)
+    if (balance > 1 && compareNode(prefix, word, root->left) < 0)
         return rightRotate(root);
 
     // Caso Direita-Direita
-    if (balance < -1 && strcmp(word, root->right->word) > 0)
+    if (balance < -1 && compareNode(prefix, word, root->right) > 0)
         return leftRotate(root);
 
     // Caso Esquerda-Direita
-    if (balance > 1 && strcmp(word, root->left->word) > 0) {
+    if (balance > 1 && compareNode(prefix, word, root->left) > 0) {
         root->left = leftRotate(root->left);
         return rightRotate(root);
     }
 
     // Caso Direita-Esquerda
-    if (balance < -1 && strcmp(word, root->right->word) < 0) {
+    if (balance < -1 && compareNode(prefix, word, root->right) < 0) {
         root->right = rightRotate(root->right);
         return leftRotate(root);
     }
@@ -125,26 +105,26 @@ AVLNode* avl_insert(AVLNode *root, const char *word, long offset) {
     return root;
 }
 
+AVLNode* avl_insert(AVLNode *root, const char *word, uint32_t doc, TreePool *pool) {
+    char prefix[KEY_PREFIX_LEN];
+    key_make_prefix(prefix, word);
+    return insertNode(root, prefix, word, doc, pool);
+}
+
 // Pesquisa a palavra na árvore AVL
 AVLNode* avl_search(AVLNode *root, const char *word) {
-    if (root == NULL)
-        return NULL;
-    int cmp = strcmp(word, root->word);
-    if (cmp == 0)
-        return root;
-    else if (cmp < 0)
-        return avl_search(root->left, word);
-    else
-        return avl_search(root->right, word);
+    char prefix[KEY_PREFIX_LEN];
+    key_make_prefix(prefix, word);
+    while (root != NULL) {
+        int cmp = compareNode(prefix, word, root);
+        if (cmp == 0)
+            return root;
+        root = (cmp < 0) ? root->left : root->right;
+    }
+    return NULL;
 }
 
-// Libera a memória da árvore AVL (pós-ordem)
-void avl_free(AVLNode *root) {
-    if (root == NULL)
-        return;
-    avl_free(root->left);
-    avl_free(root->right);
-    free(root->word);
-    free(root->offsets);
-    free(root);
+// Libera a memória da árvore AVL: basta devolver os slabs do pool
+void avl_free(TreePool *pool) {
+    tree_pool_destroy(pool);
 }
@@ -4,26 +4,29 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "pool.h"
+#include "postings.h"
+#include "word_key.h"
 
 // Estrutura do nó da Árvore AVL
+// Apenas os campos usados na descida da árvore ficam no nó; a palavra completa,
+// a frequência e os documentos ficam em Postings (dados frios, em outro pool).
 typedef struct AVLNode {
-    char *word;              // Palavra armazenada
-    int frequency;           // Frequência da palavra
-    long *offsets;           // Lista dinâmica de offsets
-    int count_offsets;       // Quantidade de offsets armazenados
-    int capacity_offsets;    // Capacidade atual do vetor de offsets
+    char prefix[KEY_PREFIX_LEN]; // Primeiros bytes da palavra (completados com '\0')
+    int32_t height;          // Altura do nó
     struct AVLNode *left;    // Ponteiro para filho à esquerda
     struct AVLNode *right;   // Ponteiro para filho à direita
-    int height;              // Altura do nó
+    Postings *postings;      // Palavra completa, frequência e documentos
 } AVLNode;
 
 // Insere (ou atualiza) uma palavra na árvore AVL e retorna a raiz atualizada.
-AVLNode* avl_insert(AVLNode *root, const char *word, long offset);
+// Nós, palavras e documentos são alocados do pool da árvore.
+AVLNode* avl_insert(AVLNode *root, const char *word, uint32_t doc, TreePool *pool);
 
 // Pesquisa uma palavra na árvore AVL e retorna o nó correspondente ou NULL se não encontrar.
 AVLNode* avl_search(AVLNode *root, const char *word);
 
-// Libera a memória alocada para a árvore AVL.
-void avl_free(AVLNode *root);
+// Libera a memória alocada para a árvore AVL, devolvendo os slabs do pool (sem percorrer os nós).
+void avl_free(TreePool *pool);
 
 #endif // AVL_H
@@ -0,0 +1,133 @@
+#define _GNU_SOURCE
+#include "batch_search.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define MAX_BATCH_THREADS 64
+
+// Consulta do lote com sua posição original (para devolver o resultado no lugar certo)
+typedef struct {
+    const char *word;
+    int pos;
+} BatchQuery;
+
+// Parte contígua (já ordenada) do lote atribuída a uma thread
+typedef struct {
+    Vector *vec;
+    const BatchQuery *queries;
+    int count;
+    WordEntry **results;
+} BatchChunk;
+
+// Ordena as consultas alfabeticamente
+static int compareQuery(const void *a, const void *b) {
+    return strcmp(((const BatchQuery *)a)->word, ((const BatchQuery *)b)->word);
+}
+
+// Menor índice em [low, vec->size) cuja palavra é >= word, procurando primeiro com
+// passos dobrando a partir de low (busca exponencial) e depois por busca binária
+static int lowerBoundFrom(const Vector *vec, int low, const char *word) {
+    int step = 1;
+    int high = low;
+    while (high < vec->size && strcmp(vec->entries[high].word, word) < 0) {
+        low = high + 1;
+        high += step;
+        step *= 2;
+    }
+    if (high > vec->size)
+        high = vec->size;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (strcmp(vec->entries[mid].word, word) < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+// Resolve uma parte do lote em uma passada de merge pelo vetor (ou pela hash perfeita,
+// com o vetor congelado)
+static void* resolveChunk(void *arg) {
+    BatchChunk *chunk = (BatchChunk *)arg;
+    Vector *vec = chunk->vec;
+    if (vec->mphf != NULL) {
+        for (int i = 0; i < chunk->count; i++)
+            chunk->results[chunk->queries[i].pos] = vector_search_entry(vec, chunk->queries[i].word);
+        return NULL;
+    }
+    int cursor = 0;
+    for (int i = 0; i < chunk->count; i++) {
+        const BatchQuery *q = &chunk->queries[i];
+        cursor = lowerBoundFrom(vec, cursor, q->word);
+        if (cursor < vec->size && strcmp(vec->entries[cursor].word, q->word) == 0)
+            chunk->results[q->pos] = &vec->entries[cursor];
+        else
+            chunk->results[q->pos] = NULL;
+    }
+    return NULL;
+}
+
+void vector_batch_search(Vector *vec, const char **words, int n, WordEntry **results, int threads) {
+    if (n <= 0)
+        return;
+    BatchQuery *queries = (BatchQuery *)malloc(n * sizeof(BatchQuery));
+    if (queries == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o lote de consultas.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++) {
+        queries[i].word = words[i];
+        queries[i].pos = i;
+    }
+    // O merge precisa das consultas em ordem; com a hash perfeita a ordem não importa
+    if (vec->mphf == NULL)
+        qsort(queries, n, sizeof(BatchQuery), compareQuery);
+
+    // Limita as threads para que cada uma tenha trabalho suficiente
+    if (threads > n / BATCH_MIN_PER_THREAD)
+        threads = n / BATCH_MIN_PER_THREAD;
+    if (threads > MAX_BATCH_THREADS)
+        threads = MAX_BATCH_THREADS;
+    if (threads < 1)
+        threads = 1;
+
+    BatchChunk chunks[MAX_BATCH_THREADS];
+    pthread_t ids[MAX_BATCH_THREADS];
+    int inicio = 0;
+    for (int t = 0; t < threads; t++) {
+        int fim = (int)((long long)n * (t + 1) / threads);
+        chunks[t].vec = vec;
+        chunks[t].queries = queries + inicio;
+        chunks[t].count = fim - inicio;
+        chunks[t].results = results;
+        inicio = fim;
+    }
+    // A thread chamadora resolve a primeira parte; as demais vão para novas threads
+    int criada[MAX_BATCH_THREADS] = {0};
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&ids[t], NULL, resolveChunk, &chunks[t]) == 0)
+            criada[t] = 1;
+        else
+            resolveChunk(&chunks[t]); // Sem thread disponível: resolve a parte aqui mesmo
+    }
+    resolveChunk(&chunks[0]);
+    for (int t = 1; t < threads; t++) {
+        if (criada[t])
+            pthread_join(ids[t], NULL);
+    }
+    free(queries);
+}
+
+int batch_default_threads(void) {
+#ifdef _SC_NPROCESSORS_ONLN
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n >= 1)
+        return (n > MAX_BATCH_THREADS) ? MAX_BATCH_THREADS : (int)n;
+#endif
+    return 1;
+}
@@ -0,0 +1,21 @@
+#ifndef BATCH_SEARCH_H
+#define BATCH_SEARCH_H
+
+#include "vector.h"
+
+// Quantidade mínima de consultas por thread: lotes menores são resolvidos na
+// própria thread chamadora, pois criar threads custaria mais que as buscas.
+#define BATCH_MIN_PER_THREAD 4096
+
+// Pesquisa um lote de palavras no vetor ordenado. Em vez de uma busca binária
+// independente por palavra, as consultas são ordenadas e resolvidas em uma única
+// passada de merge pelo vetor (cada busca recomeça de onde a anterior parou, com
+// busca exponencial). Com o vetor congelado, cada consulta usa a hash perfeita e o
+// lote não é ordenado. Lotes grandes são divididos entre até 'threads' threads.
+// results[i] recebe a entrada de words[i], ou NULL se a palavra não existir.
+void vector_batch_search(Vector *vec, const char **words, int n, WordEntry **results, int threads);
+
+// Número de threads sugerido para o lote (processadores disponíveis).
+int batch_default_threads(void);
+
+#endif // BATCH_SEARCH_H
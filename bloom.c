@@ -0,0 +1,120 @@
+#include "bloom.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Número máximo de bits ligados por palavra
+#define BLOOM_MAX_K 16
+
+// Hash FNV-1a de 64 bits seguido do finalizador do MurmurHash3
+static uint64_t hashWord(const char *word) {
+    uint64_t h = 14695981039346656037ULL;
+    for (const unsigned char *p = (const unsigned char *)word; *p; p++) {
+        h ^= *p;
+        h *= 1099511628211ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// Bloco da palavra: usa os 32 bits altos do hash (os baixos escolhem os bits)
+static uint64_t* blockOf(const BloomFilter *bf, uint64_t h) {
+    uint32_t b = (uint32_t)(((h >> 32) * (uint64_t)bf->block_count) >> 32);
+    return bf->blocks + (size_t)b * BLOOM_BLOCK_WORDS;
+}
+
+BloomFilter* bloom_create(uint32_t expected_keys, int bits_per_key) {
+    BloomFilter *bf = (BloomFilter *)malloc(sizeof(BloomFilter));
+    if (bf == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o filtro de Bloom.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (bits_per_key < 1)
+        bits_per_key = 1;
+    uint64_t bits = (uint64_t)expected_keys * bits_per_key;
+    bf->block_count = (uint32_t)((bits + BLOOM_BLOCK_BITS - 1) / BLOOM_BLOCK_BITS);
+    if (bf->block_count == 0)
+        bf->block_count = 1;
+    // k ótimo = bits por palavra * ln 2
+    bf->k = (int)(bits_per_key * 0.693 + 0.5);
+    if (bf->k < 1)
+        bf->k = 1;
+    if (bf->k > BLOOM_MAX_K)
+        bf->k = BLOOM_MAX_K;
+    bf->bits_per_key = bits_per_key;
+    bf->keys = 0;
+    bf->queries = 0;
+    bf->rejected = 0;
+
+    size_t bytes = (size_t)bf->block_count * BLOOM_BLOCK_WORDS * sizeof(uint64_t);
+    bf->raw = calloc(bytes + 63, 1);
+    if (bf->raw == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o filtro de Bloom.\n");
+        exit(EXIT_FAILURE);
+    }
+    // Alinha os blocos a 64 bytes para que cada um ocupe exatamente uma linha de cache
+    bf->blocks = (uint64_t *)(((uintptr_t)bf->raw + 63) & ~(uintptr_t)63);
+    return bf;
+}
+
+int bloom_add(BloomFilter *bf, const char *word) {
+    uint64_t h = hashWord(word);
+    uint64_t *block = blockOf(bf, h);
+    // Dupla hash: os k bits são h1, h1 + h2, h1 + 2*h2, ... dentro do bloco
+    uint32_t h1 = (uint32_t)h, h2 = (uint32_t)(h >> 17) | 1;
+    uint64_t novos = 0;
+    for (int i = 0; i < bf->k; i++) {
+        uint32_t bit = (h1 + (uint32_t)i * h2) % BLOOM_BLOCK_BITS;
+        uint64_t mask = (uint64_t)1 << (bit & 63);
+        novos |= ~block[bit >> 6] & mask;
+        block[bit >> 6] |= mask;
+    }
+    return novos != 0;
+}
+
+int bloom_may_contain(BloomFilter *bf, const char *word) {
+    uint64_t h = hashWord(word);
+    const uint64_t *block = blockOf(bf, h);
+    uint32_t h1 = (uint32_t)h, h2 = (uint32_t)(h >> 17) | 1;
+    bf->queries++;
+    for (int i = 0; i < bf->k; i++) {
+        uint32_t bit = (h1 + (uint32_t)i * h2) % BLOOM_BLOCK_BITS;
+        if (!(block[bit >> 6] & ((uint64_t)1 << (bit & 63)))) {
+            bf->rejected++;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+size_t bloom_memory(const BloomFilter *bf) {
+    return (size_t)bf->block_count * BLOOM_BLOCK_WORDS * sizeof(uint64_t);
+}
+
+double bloom_estimated_fpr(const BloomFilter *bf) {
+    // A quantidade de palavras em um bloco segue uma distribuição de Poisson com média
+    // lambda; a taxa é a média da taxa de um filtro de 512 bits com j palavras.
+    double lambda = (double)bf->keys / bf->block_count;
+    int limite = (int)(lambda + 10.0 * sqrt(lambda) + 20.0);
+    double prob = exp(-lambda), fpr = 0.0;
+    for (int j = 0; j <= limite; j++) {
+        if (j > 0)
+            prob *= lambda / j;
+        double ocupado = 1.0 - pow(1.0 - 1.0 / BLOOM_BLOCK_BITS, (double)bf->k * j);
+        fpr += prob * pow(ocupado, bf->k);
+    }
+    return fpr;
+}
+
+void bloom_free(BloomFilter *bf) {
+    if (bf == NULL)
+        return;
+    free(bf->raw);
+    free(bf);
+}
@@ -0,0 +1,50 @@
+#ifndef BLOOM_H
+#define BLOOM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Bits por palavra usados quando o usuário não escolhe outro valor (~1% de falsos positivos)
+#define BLOOM_DEFAULT_BITS_PER_KEY 10
+
+// Tamanho de um bloco em bits: uma linha de cache de 64 bytes
+#define BLOOM_BLOCK_BITS 512
+#define BLOOM_BLOCK_WORDS (BLOOM_BLOCK_BITS / 64)
+
+// Filtro de Bloom em blocos, consultado antes do índice para rejeitar palavras
+// ausentes. Cada palavra escolhe um único bloco pelo hash e liga k bits dentro dele,
+// então uma consulta lê uma só linha de cache. "Não" é sempre correto; "talvez"
+// pode ser um falso positivo e precisa ser confirmado na estrutura.
+typedef struct BloomFilter {
+    uint64_t *blocks;        // Blocos de BLOOM_BLOCK_WORDS palavras (alinhados a 64 bytes)
+    void *raw;               // Memória alocada (antes do alinhamento)
+    uint32_t block_count;    // Quantidade de blocos
+    int k;                   // Bits ligados por palavra
+    int bits_per_key;        // Bits por palavra pedidos na criação
+    uint32_t keys;           // Palavras distintas no filtro (mantido por quem adiciona)
+    long queries;            // Consultas feitas ao filtro
+    long rejected;           // Consultas rejeitadas (palavra certamente ausente)
+} BloomFilter;
+
+// Cria um filtro dimensionado para 'expected_keys' palavras com 'bits_per_key' bits cada.
+BloomFilter* bloom_create(uint32_t expected_keys, int bits_per_key);
+
+// Adiciona uma palavra ao filtro. Retorna 1 se algum bit foi ligado (a palavra
+// certamente era nova), 0 caso contrário. Não altera 'keys': quem adiciona as palavras
+// mantém a contagem, que é a base de bloom_estimated_fpr.
+int bloom_add(BloomFilter *bf, const char *word);
+
+// Retorna 0 se a palavra certamente não foi adicionada, 1 se talvez tenha sido.
+int bloom_may_contain(BloomFilter *bf, const char *word);
+
+// Memória ocupada pelos blocos, em bytes.
+size_t bloom_memory(const BloomFilter *bf);
+
+// Taxa de falsos positivos esperada para as palavras adicionadas (entre 0 e 1),
+// considerando a ocupação desigual dos blocos.
+double bloom_estimated_fpr(const BloomFilter *bf);
+
+// Libera o filtro.
+void bloom_free(BloomFilter *bf);
+
+#endif // BLOOM_H
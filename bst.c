@@ -4,81 +4,57 @@
 #include <stdlib.h>
 #include <string.h>
 
-#define INITIAL_OFFSET_CAPACITY 10
-
-// Cria um novo nó da BST com a palavra e offset fornecidos
-static BSTNode* createBSTNode(const char *word, long offset) {
-    BSTNode *node = (BSTNode *)malloc(sizeof(BSTNode));
-    if (node == NULL) {
-        fprintf(stderr, "Erro ao alocar memória para BSTNode.\n");
-        exit(EXIT_FAILURE);
-    }
-    node->word = strdup(word);
-    if (node->word == NULL) {
-        fprintf(stderr, "Erro ao alocar memória para a palavra.\n");
-        exit(EXIT_FAILURE);
-    }
-    node->frequency = 1;
-    node->capacity_offsets = INITIAL_OFFSET_CAPACITY;
-    node->count_offsets = 0;
-    node->offsets = (long *)malloc(INITIAL_OFFSET_CAPACITY * sizeof(long));
-    if (node->offsets == NULL) {
-        fprintf(stderr, "Erro ao alocar memória para offsets.\n");
-        exit(EXIT_FAILURE);
-    }
-    node->offsets[node->count_offsets++] = offset;
+// Cria um novo nó da BST com a palavra e documento fornecidos (alocado do pool)
+static BSTNode* createBSTNode(const char *prefix, const char *word, uint32_t doc, TreePool *pool) {
+    BSTNode *node = (BSTNode *)pool_alloc(&pool->nodes, sizeof(BSTNode));
+    memcpy(node->prefix, prefix, KEY_PREFIX_LEN);
+    // Palavras curtas cabem no prefixo e não precisam de cópia separada
+    const char *full = key_is_inline(node->prefix) ? node->prefix : pool_strdup(&pool->postings, word);
+    node->postings = postings_create(&pool->postings, full, doc);
     node->left = node->right = NULL;
     return node;
 }
 
-// Insere ou atualiza um nó na BST
-BSTNode* bst_insert(BSTNode *root, const char *word, long offset) {
-    if (root == NULL) {
-        return createBSTNode(word, offset);
-    }
-    int cmp = strcmp(word, root->word);
-    if (cmp == 0) {
-        // Palavra já existe: atualiza a frequência e adiciona o offset
-        root->frequency++;
-        if (root->count_offsets >= root->capacity_offsets) {
-            root->capacity_offsets *= 2;
-            root->offsets = realloc(root->offsets, root->capacity_offsets * sizeof(long));
-            if (root->offsets == NULL) {
-                fprintf(stderr, "Erro ao realocar memória para offsets na BST.\n");
-                exit(EXIT_FAILURE);
-            }
+// Insere ou atualiza um nó na BST (o prefixo da palavra é calculado uma única vez). É
+// iterativo: com palavras em ordem crescente a árvore vira uma lista e a recursão
+// estouraria a pilha.
+static BSTNode* insertNode(BSTNode *root, const char *prefix, const char *word, uint32_t doc, TreePool *pool) {
+    BSTNode **link = &root;
+    while (*link != NULL) {
+        BSTNode *node = *link;
+        int cmp = key_compare(prefix, word, node->prefix, &node->postings->word);
+        if (cmp == 0) {
+            // Palavra já existe: atualiza a frequência e adiciona o documento
+            postings_add(node->postings, doc, &pool->postings);
+            return root;
         }
-        root->offsets[root->count_offsets++] = offset;
-    } else if (cmp < 0) {
-        // Se a palavra for menor, insere à esquerda
-        root->left = bst_insert(root->left, word, offset);
-    } else {
-        // Se a palavra for maior, insere à direita
-        root->right = bst_insert(root->right, word, offset);
+        // Se a palavra for menor, segue à esquerda; se for maior, à direita
+        link = (cmp < 0) ? &node->left : &node->right;
     }
+    *link = createBSTNode(prefix, word, doc, pool);
     return root;
 }
 
+BSTNode* bst_insert(BSTNode *root, const char *word, uint32_t doc, TreePool *pool) {
+    char prefix[KEY_PREFIX_LEN];
+    key_make_prefix(prefix, word);
+    return insertNode(root, prefix, word, doc, pool);
+}
+
 // Pesquisa a palavra na BST
 BSTNode* bst_search(BSTNode *root, const char *word) {
-    if (root == NULL)
-        return NULL;
-    int cmp = strcmp(word, root->word);
-    if (cmp == 0)
-        return root;
-    else if (cmp < 0)
-        return bst_search(root->left, word);
-    else
-        return bst_search(root->right, word);
+    char prefix[KEY_PREFIX_LEN];
+    key_make_prefix(prefix, word);
+    while (root != NULL) {
+        int cmp = key_compare(prefix, word, root->prefix, &root->postings->word);
+        if (cmp == 0)
+            return root;
+        root = (cmp < 0) ? root->left : root->right;
+    }
+    return NULL;
 }
 
-// Libera a memória alocada para a BST (pós-ordem)
-void bst_free(BSTNode *root) {
-    if (root == NULL)
-        return;
-    bst_free(root->left);
-    bst_free(root->right);
-    free(root->word);
-    free(root->offsets);
-    free(root);
+// Libera a memória alocada para a BST: basta devolver os slabs do pool
+void bst_free(TreePool *pool) {
+    tree_pool_destroy(pool);
 }
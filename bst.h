@@ -4,25 +4,28 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "pool.h"
+#include "postings.h"
+#include "word_key.h"
 
 // Estrutura do nó da Árvore Binária de Busca (BST)
+// Apenas os campos usados na descida da árvore ficam no nó; a palavra completa,
+// a frequência e os documentos ficam em Postings (dados frios, em outro pool).
 typedef struct BSTNode {
-    char *word;              // Palavra armazenada
-    int frequency;           // Frequência da palavra
-    long *offsets;           // Lista dinâmica de offsets
-    int count_offsets;       // Quantidade de offsets armazenados
-    int capacity_offsets;    // Capacidade atual do vetor de offsets
+    char prefix[KEY_PREFIX_LEN]; // Primeiros bytes da palavra (completados com '\0')
     struct BSTNode *left;    // Ponteiro para filho à esquerda
     struct BSTNode *right;   // Ponteiro para filho à direita
+    Postings *postings;      // Palavra completa, frequência e documentos
 } BSTNode;
 
 // Insere (ou atualiza) uma palavra na BST e retorna a raiz atualizada.
-BSTNode* bst_insert(BSTNode *root, const char *word, long offset);
+// Nós, palavras e documentos são alocados do pool da árvore.
+BSTNode* bst_insert(BSTNode *root, const char *word, uint32_t doc, TreePool *pool);
 
 // Pesquisa uma palavra na BST e retorna o nó correspondente ou NULL se não encontrar.
 BSTNode* bst_search(BSTNode *root, const char *word);
 
-// Libera a memória alocada para a BST.
-void bst_free(BSTNode *root);
+// Libera a memória alocada para a BST, devolvendo os slabs do pool (sem percorrer os nós).
+void bst_free(TreePool *pool);
 
 #endif // BST_H
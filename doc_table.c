@@ -0,0 +1,67 @@
+#include "doc_table.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Capacidade inicial do vetor de offsets
+#define INITIAL_DOC_CAPACITY 1024
+
+void doc_table_init(DocTable *table) {
+    table->offsets = NULL;
+    table->count = 0;
+    table->capacity = 0;
+}
+
+uint32_t doc_table_add(DocTable *table, long offset) {
+    if (table->count >= table->capacity) {
+        table->capacity = (table->capacity == 0) ? INITIAL_DOC_CAPACITY : table->capacity * 2;
+        table->offsets = realloc(table->offsets, table->capacity * sizeof(long));
+        if (table->offsets == NULL) {
+            fprintf(stderr, "Erro ao realocar memória para a tabela de documentos.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    table->offsets[table->count] = offset;
+    return table->count++;
+}
+
+uint32_t doc_table_append(DocTable *table, const DocTable *other) {
+    uint32_t first = table->count;
+    if (table->count + other->count > table->capacity) {
+        while (table->count + other->count > table->capacity)
+            table->capacity = (table->capacity == 0) ? INITIAL_DOC_CAPACITY : table->capacity * 2;
+        table->offsets = realloc(table->offsets, table->capacity * sizeof(long));
+        if (table->offsets == NULL) {
+            fprintf(stderr, "Erro ao realocar memória para a tabela de documentos.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (other->count > 0)
+        memcpy(table->offsets + table->count, other->offsets, other->count * sizeof(long));
+    table->count += other->count;
+    return first;
+}
+
+uint32_t doc_table_find(const DocTable *table, long offset) {
+    uint32_t low = 0, high = table->count;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (table->offsets[mid] < offset)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    if (low < table->count && table->offsets[low] == offset)
+        return low;
+    return DOC_NOT_FOUND;
+}
+
+size_t doc_table_memory(const DocTable *table) {
+    return table->capacity * sizeof(long);
+}
+
+void doc_table_free(DocTable *table) {
+    free(table->offsets);
+    doc_table_init(table);
+}
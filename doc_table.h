@@ -0,0 +1,43 @@
+#ifndef DOC_TABLE_H
+#define DOC_TABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Valor devolvido por doc_table_find quando o offset não é início de documento
+#define DOC_NOT_FOUND UINT32_MAX
+
+// Tabela de documentos: cada linha lida do arquivo de citações recebe um ID denso de
+// 32 bits (0, 1, 2, ... na ordem do arquivo), e offsets[id] guarda a posição da linha.
+// Os índices guardam apenas IDs; o offset só é consultado para exibir a citação.
+typedef struct {
+    long *offsets;           // Offset de cada documento, em ordem crescente
+    uint32_t count;          // Quantidade de documentos
+    uint32_t capacity;       // Capacidade atual do vetor
+} DocTable;
+
+// Inicializa uma tabela vazia.
+void doc_table_init(DocTable *table);
+
+// Registra a próxima linha do arquivo e retorna seu ID.
+uint32_t doc_table_add(DocTable *table, long offset);
+
+// Acrescenta os documentos de 'other' (que vêm depois dos já registrados) e retorna o
+// ID do primeiro deles.
+uint32_t doc_table_append(DocTable *table, const DocTable *other);
+
+// Offset da linha do documento.
+static inline long doc_table_offset(const DocTable *table, uint32_t doc) {
+    return table->offsets[doc];
+}
+
+// ID do documento que começa no offset (busca binária) ou DOC_NOT_FOUND.
+uint32_t doc_table_find(const DocTable *table, long offset);
+
+// Memória ocupada pela tabela, em bytes.
+size_t doc_table_memory(const DocTable *table);
+
+// Libera a tabela (ela pode ser preenchida de novo depois de doc_table_init).
+void doc_table_free(DocTable *table);
+
+#endif // DOC_TABLE_H
@@ -0,0 +1,169 @@
+#include "freq_table.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+// Palavra excedente durante a construção (ordenada depois por frequência)
+typedef struct {
+    int frequency;
+    const char *word;
+} Excedente;
+
+// Estado das duas passadas de construção
+typedef struct {
+    FreqTable *ft;
+    int maxFrequency;            // Maior frequência encontrada (1ª passada)
+    int *cursor;                 // Próxima posição livre de cada bucket (2ª passada)
+    Excedente *excedentes;
+    int countExcedentes;
+} Construcao;
+
+static void* xmalloc(size_t size) {
+    void *ptr = malloc(size > 0 ? size : 1);
+    if (ptr == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a tabela de frequencias.\n");
+        exit(EXIT_FAILURE);
+    }
+    return ptr;
+}
+
+// 1ª passada: conta as palavras de cada frequência
+static void contarPalavra(const IndexEntry *entry, void *ctx) {
+    Construcao *c = (Construcao *)ctx;
+    FreqTable *ft = c->ft;
+    ft->count++;
+    if (entry->frequency > c->maxFrequency)
+        c->maxFrequency = entry->frequency;
+    if (entry->frequency < FREQ_TABLE_DENSE_LIMIT)
+        ft->bucket_start[entry->frequency + 1]++;
+    else
+        ft->overflow_count++;
+}
+
+// 2ª passada: copia cada palavra para a posição final
+static void posicionarPalavra(const IndexEntry *entry, void *ctx) {
+    Construcao *c = (Construcao *)ctx;
+    if (entry->frequency < c->ft->dense_limit) {
+        c->ft->words[c->cursor[entry->frequency]++] = entry->word;
+    } else {
+        c->excedentes[c->countExcedentes].frequency = entry->frequency;
+        c->excedentes[c->countExcedentes].word = entry->word;
+        c->countExcedentes++;
+    }
+}
+
+// Ordena os excedentes por frequência e, em caso de empate, alfabeticamente
+static int compararExcedentes(const void *a, const void *b) {
+    const Excedente *x = (const Excedente *)a, *y = (const Excedente *)b;
+    if (x->frequency != y->frequency)
+        return (x->frequency > y->frequency) - (x->frequency < y->frequency);
+    return strcmp(x->word, y->word);
+}
+
+void freq_table_build(FreqTable *ft, Index *source) {
+    memset(ft, 0, sizeof(FreqTable));
+    Construcao c;
+    memset(&c, 0, sizeof(c));
+    c.ft = ft;
+
+    // Contagem com o limite máximo; depois o limite é reduzido à maior frequência
+    ft->bucket_start = (int *)calloc(FREQ_TABLE_DENSE_LIMIT + 1, sizeof(int));
+    if (ft->bucket_start == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a tabela de frequencias.\n");
+        exit(EXIT_FAILURE);
+    }
+    index_foreach(source, contarPalavra, &c);
+    ft->dense_limit = (c.maxFrequency + 1 < FREQ_TABLE_DENSE_LIMIT) ? c.maxFrequency + 1
+                                                                     : FREQ_TABLE_DENSE_LIMIT;
+    for (int f = 0; f < ft->dense_limit; f++)
+        ft->bucket_start[f + 1] += ft->bucket_start[f];
+    ft->bucket_start = realloc(ft->bucket_start, (ft->dense_limit + 1) * sizeof(int));
+    if (ft->bucket_start == NULL) {
+        fprintf(stderr, "Erro ao realocar memória para a tabela de frequencias.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    ft->words = (const char **)xmalloc(ft->count * sizeof(char *));
+    c.cursor = (int *)xmalloc(ft->dense_limit * sizeof(int));
+    memcpy(c.cursor, ft->bucket_start, ft->dense_limit * sizeof(int));
+    c.excedentes = (Excedente *)xmalloc(ft->overflow_count * sizeof(Excedente));
+    index_foreach(source, posicionarPalavra, &c);
+
+    // Os excedentes são poucos: uma ordenação comum basta
+    qsort(c.excedentes, c.countExcedentes, sizeof(Excedente), compararExcedentes);
+    ft->overflow_freqs = (int *)xmalloc(ft->overflow_count * sizeof(int));
+    int base = ft->bucket_start[ft->dense_limit];
+    for (int i = 0; i < c.countExcedentes; i++) {
+        ft->words[base + i] = c.excedentes[i].word;
+        ft->overflow_freqs[i] = c.excedentes[i].frequency;
+    }
+    free(c.excedentes);
+    free(c.cursor);
+}
+
+// Primeira posição dos excedentes com frequência >= f
+static int primeiroExcedente(const FreqTable *ft, int f) {
+    int low = 0, high = ft->overflow_count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (ft->overflow_freqs[mid] < f)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+// Faixa [*inicio, *fim) do vetor words com frequência em [min, max]
+static void faixa(const FreqTable *ft, int min, int max, int *inicio, int *fim) {
+    if (min < 0)
+        min = 0;
+    int base = ft->bucket_start[ft->dense_limit];
+    if (max < min) {
+        *inicio = *fim = 0;
+        return;
+    }
+    *inicio = (min < ft->dense_limit) ? ft->bucket_start[min] : base + primeiroExcedente(ft, min);
+    if (max < ft->dense_limit - 1)
+        *fim = ft->bucket_start[max + 1];
+    else if (max == INT_MAX)
+        *fim = ft->count;
+    else
+        *fim = base + primeiroExcedente(ft, max + 1);
+}
+
+int freq_table_lookup(const FreqTable *ft, int frequency, const char *const **words) {
+    int inicio, fim;
+    faixa(ft, frequency, frequency, &inicio, &fim);
+    *words = ft->words + inicio;
+    return fim - inicio;
+}
+
+int freq_table_range(const FreqTable *ft, int min, int max, FreqTableVisitFn visit, void *ctx) {
+    int inicio, fim;
+    faixa(ft, min, max, &inicio, &fim);
+    if (visit != NULL) {
+        int base = ft->bucket_start[ft->dense_limit];
+        // Frequência da primeira palavra da faixa; avança a cada fim de bucket
+        int f = (min < 0) ? 0 : min;
+        for (int i = inicio; i < fim; i++) {
+            if (i >= base) {
+                f = ft->overflow_freqs[i - base];
+            } else {
+                while (ft->bucket_start[f + 1] <= i)
+                    f++;
+            }
+            visit(ft->words[i], f, ctx);
+        }
+    }
+    return fim - inicio;
+}
+
+void freq_table_free(FreqTable *ft) {
+    free(ft->bucket_start);
+    free(ft->words);
+    free(ft->overflow_freqs);
+    memset(ft, 0, sizeof(FreqTable));
+}
@@ -0,0 +1,44 @@
+#ifndef FREQ_TABLE_H
+#define FREQ_TABLE_H
+
+#include "index.h"
+
+// Maior quantidade de buckets densos. Frequências a partir desse valor (raras, por ser
+// uma distribuição de cauda longa) vão para a faixa ordenada de excedentes.
+#define FREQ_TABLE_DENSE_LIMIT 1024
+
+// Função chamada para cada palavra de uma consulta por intervalo.
+typedef void (*FreqTableVisitFn)(const char *word, int frequency, void *ctx);
+
+// Índice de frequências em tabela. As palavras ficam em um único vetor contíguo,
+// ordenado por frequência (e, dentro de cada frequência, em ordem alfabética):
+// - frequências menores que dense_limit têm um bucket cada, e bucket_start[f] é a
+//   posição da primeira palavra com frequência f (bucket_start[f+1] marca o fim);
+// - as demais ficam depois dos buckets, com suas frequências em overflow_freqs.
+typedef struct {
+    int dense_limit;             // Frequências em [0, dense_limit) usam os buckets
+    int *bucket_start;           // dense_limit + 1 posições de início em words
+    const char **words;          // Todas as palavras (pertencem ao índice de origem)
+    int count;                   // Total de palavras
+    int overflow_count;          // Palavras com frequência >= dense_limit
+    int *overflow_freqs;         // Frequências dessas palavras, em ordem crescente
+} FreqTable;
+
+// Constrói a tabela com todas as palavras do índice por contagem (counting sort):
+// uma passada conta as palavras de cada frequência e a segunda as copia para a posição
+// final. As palavras continuam pertencendo ao índice, que deve viver mais que a tabela.
+void freq_table_build(FreqTable *ft, Index *source);
+
+// Palavras com exatamente a frequência informada: retorna a quantidade e aponta *words
+// para a primeira delas (contíguas). O(1) para frequências densas.
+int freq_table_lookup(const FreqTable *ft, int frequency, const char *const **words);
+
+// Percorre as palavras com frequência em [min, max] em ordem crescente de frequência
+// (varredura linear do vetor) e retorna quantas foram visitadas. 'visit' pode ser NULL
+// para apenas contar.
+int freq_table_range(const FreqTable *ft, int min, int max, FreqTableVisitFn visit, void *ctx);
+
+// Libera a tabela.
+void freq_table_free(FreqTable *ft);
+
+#endif // FREQ_TABLE_H
@@ -2,7 +2,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include "vector.h"
+#include <time.h>
 
 #define INITIAL_WORDS_CAPACITY 5
 
@@ -16,23 +16,15 @@ static int maxFreq(int a, int b) {
     return (a > b) ? a : b;
 }
 
-// Cria um novo nó de frequência com a entrada fornecida
-static FreqNode* createFreqNode(int frequency, WordEntry *entry) {
-    FreqNode *node = (FreqNode *)malloc(sizeof(FreqNode));
-    if (node == NULL) {
-        fprintf(stderr, "Erro ao alocar memória para FreqNode.\n");
-        exit(EXIT_FAILURE);
-    }
+// Cria um novo nó de frequência com a palavra fornecida (alocado do pool)
+static FreqNode* createFreqNode(int frequency, const char *word, TreePool *pool) {
+    FreqNode *node = (FreqNode *)pool_alloc(&pool->nodes, sizeof(FreqNode));
     node->frequency = frequency;
     node->capacity_words = INITIAL_WORDS_CAPACITY;
     node->count_words = 0;
-    node->words = (WordEntry **)malloc(node->capacity_words * sizeof(WordEntry *));
-    if (node->words == NULL) {
-        fprintf(stderr, "Erro ao alocar memória para vetor de palavras na FreqNode.\n");
-        exit(EXIT_FAILURE);
-    }
-    // Adiciona a entrada
-    node->words[node->count_words++] = entry;
+    node->words = (const char **)pool_alloc(&pool->postings, node->capacity_words * sizeof(const char *));
+    // Adiciona a palavra
+    node->words[node->count_words++] = word;
     node->left = node->right = NULL;
     node->height = 1;
     return node;
@@ -65,26 +57,24 @@ static int getBalanceFreq(FreqNode *node) {
     return (node == NULL) ? 0 : heightFreq(node->left) - heightFreq(node->right);
 }
 
-// Insere uma entrada na árvore AVL de frequência
-FreqNode* freq_avl_insert(FreqNode *root, int frequency, WordEntry *entry) {
+// Insere uma palavra na árvore AVL de frequência
+FreqNode* freq_avl_insert(FreqNode *root, int frequency, const char *word, TreePool *pool) {
     if (root == NULL)
-        return createFreqNode(frequency, entry);
+        return createFreqNode(frequency, word, pool);
 
     if (frequency < root->frequency)
-        root->left = freq_avl_insert(root->left, frequency, entry);
+        root->left = freq_avl_insert(root->left, frequency, word, pool);
     else if (frequency > root->frequency)
-        root->right = freq_avl_insert(root->right, frequency, entry);
+        root->right = freq_avl_insert(root->right, frequency, word, pool);
     else {
-        // Frequência já existe: adiciona a entrada no vetor de palavras
+        // Frequência já existe: adiciona a palavra no vetor de palavras
         if (root->count_words >= root->capacity_words) {
+            root->words = pool_realloc(&pool->postings, root->words,
+                                       root->capacity_words * sizeof(const char *),
+                                       root->capacity_words * 2 * sizeof(const char *));
             root->capacity_words *= 2;
-            root->words = realloc(root->words, root->capacity_words * sizeof(WordEntry *));
-            if (root->words == NULL) {
-                fprintf(stderr, "Erro ao realocar memória para vetor de palavras na FreqNode.\n");
-                exit(EXIT_FAILURE);
-            }
         }
-        root->words[root->count_words++] = entry;
+        root->words[root->count_words++] = word;
         return root;
     }
 
@@ -125,12 +115,31 @@ FreqNode* freq_avl_search(FreqNode *root, int frequency) {
         return freq_avl_search(root->right, frequency);
 }
 
-// Libera a memória da árvore de frequência (pós-ordem)
-void freq_avl_free(FreqNode *root) {
-    if (root == NULL)
-        return;
-    freq_avl_free(root->left);
-    freq_avl_free(root->right);
-    free(root->words);
-    free(root);
+// Libera a memória da árvore de frequência: basta devolver os slabs do pool
+void freq_avl_free(TreePool *pool) {
+    tree_pool_destroy(pool);
+}
+
+// Insere cada palavra do índice na árvore de frequência (usada com index_foreach)
+static void insertEntry(const IndexEntry *entry, void *ctx) {
+    FreqIndex *fi = (FreqIndex *)ctx;
+    fi->root = freq_avl_insert(fi->root, entry->frequency, entry->word, &fi->pool);
+}
+
+void freq_index_build(FreqIndex *fi, Index *source) {
+    fi->root = NULL;
+    tree_pool_init(&fi->pool);
+    clock_t inicio = clock();
+    index_foreach(source, insertEntry, fi);
+    clock_t meio = clock();
+    freq_table_build(&fi->table, source);
+    clock_t fim = clock();
+    fi->tree_time = ((double)(meio - inicio)) / CLOCKS_PER_SEC;
+    fi->table_time = ((double)(fim - meio)) / CLOCKS_PER_SEC;
+}
+
+void freq_index_free(FreqIndex *fi) {
+    freq_avl_free(&fi->pool);
+    freq_table_free(&fi->table);
+    fi->root = NULL;
 }
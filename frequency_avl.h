@@ -1,12 +1,14 @@
 #ifndef FREQUENCY_AVL_H
 #define FREQUENCY_AVL_H
 
-#include "vector.h"
+#include "pool.h"
+#include "index.h"
+#include "freq_table.h"
 
 // Estrutura do nó da árvore AVL organizada por frequência.
 typedef struct FreqNode {
     int frequency;             // Frequência (chave)
-    WordEntry **words;         // Vetor de ponteiros para WordEntry com essa frequência
+    const char **words;        // Vetor de ponteiros para as palavras com essa frequência
     int count_words;           // Número de palavras armazenadas neste nó
     int capacity_words;        // Capacidade atual do vetor de palavras
     struct FreqNode *left;     // Filho esquerdo
@@ -14,14 +16,32 @@ typedef struct FreqNode {
     int height;                // Altura do nó
 } FreqNode;
 
-// Insere uma entrada (WordEntry) na árvore de frequências. Se já existir um nó com a mesma frequência,
-// adiciona a entrada no vetor de palavras.
-FreqNode* freq_avl_insert(FreqNode *root, int frequency, WordEntry *entry);
+// Insere uma palavra na árvore de frequências. Se já existir um nó com a mesma frequência,
+// adiciona a palavra no vetor de palavras. A string não é copiada: ela pertence ao índice de origem.
+// Os nós e os vetores de palavras são alocados do pool da árvore.
+FreqNode* freq_avl_insert(FreqNode *root, int frequency, const char *word, TreePool *pool);
 
 // Pesquisa um nó na árvore de frequências para uma dada frequência.
 FreqNode* freq_avl_search(FreqNode *root, int frequency);
 
-// Libera a memória alocada para a árvore AVL de frequência.
-void freq_avl_free(FreqNode *root);
+// Libera a memória alocada para a árvore AVL de frequência, devolvendo os slabs do pool.
+void freq_avl_free(TreePool *pool);
+
+// Árvore de frequência completa de um índice e o pool de onde seus nós são alocados.
+// A tabela de frequências é construída junto, como alternativa à árvore.
+typedef struct {
+    FreqNode *root;
+    TreePool pool;
+    FreqTable table;           // Índice de frequências em tabela (buckets densos)
+    double tree_time;          // Tempo de construção da árvore (segundos)
+    double table_time;         // Tempo de construção da tabela (segundos)
+} FreqIndex;
+
+// Constrói a árvore de frequência e a tabela com todas as palavras do índice de origem.
+// As palavras continuam pertencendo ao índice, que deve viver mais que a árvore.
+void freq_index_build(FreqIndex *fi, Index *source);
+
+// Libera a árvore e a tabela de frequência.
+void freq_index_free(FreqIndex *fi);
 
 #endif // FREQUENCY_AVL_H
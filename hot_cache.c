@@ -0,0 +1,66 @@
+#include "hot_cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Hash FNV-1a de 32 bits
+static unsigned int hashWord(const char *word) {
+    unsigned int h = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)word; *p; p++) {
+        h ^= *p;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+HotCache* hot_cache_create(int slots) {
+    HotCache *cache = (HotCache *)malloc(sizeof(HotCache));
+    if (cache == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o cache de termos.\n");
+        exit(EXIT_FAILURE);
+    }
+    cache->size = 1;
+    while (cache->size < slots)
+        cache->size *= 2;
+    cache->slots = (HotCacheSlot *)calloc(cache->size, sizeof(HotCacheSlot));
+    if (cache->slots == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o cache de termos.\n");
+        exit(EXIT_FAILURE);
+    }
+    cache->stored = 0;
+    cache->hits = 0;
+    cache->misses = 0;
+    return cache;
+}
+
+int hot_cache_lookup(HotCache *cache, const char *word, IndexEntry *out) {
+    HotCacheSlot *slot = &cache->slots[hashWord(word) & (cache->size - 1)];
+    if (slot->word != NULL && strcmp(slot->word, word) == 0) {
+        *out = slot->entry;
+        cache->hits++;
+        return 1;
+    }
+    cache->misses++;
+    return 0;
+}
+
+void hot_cache_store(HotCache *cache, const IndexEntry *entry) {
+    HotCacheSlot *slot = &cache->slots[hashWord(entry->word) & (cache->size - 1)];
+    slot->word = entry->word;
+    slot->entry = *entry;
+    cache->stored++;
+}
+
+void hot_cache_clear(HotCache *cache) {
+    if (cache->stored > 0)
+        memset(cache->slots, 0, cache->size * sizeof(HotCacheSlot));
+    cache->stored = 0;
+}
+
+void hot_cache_free(HotCache *cache) {
+    if (cache == NULL)
+        return;
+    free(cache->slots);
+    free(cache);
+}
@@ -0,0 +1,39 @@
+#ifndef HOT_CACHE_H
+#define HOT_CACHE_H
+
+#include "index.h"
+
+// Posição do cache: guarda o resultado de uma busca bem-sucedida.
+typedef struct {
+    const char *word;        // Palavra armazenada (NULL = posição vazia)
+    IndexEntry entry;        // Resultado da busca
+} HotCacheSlot;
+
+// Cache pequeno de termos frequentes, consultado antes do índice. É mapeado
+// diretamente (cada palavra tem uma única posição possível, dada pelo hash),
+// então uma consulta custa um hash e uma comparação de strings.
+typedef struct HotCache {
+    HotCacheSlot *slots;     // Vetor de posições
+    int size;                // Quantidade de posições (potência de 2)
+    int stored;              // Quantidade de resultados guardados desde a última limpeza
+    long hits;               // Consultas respondidas pelo cache
+    long misses;             // Consultas que foram ao índice
+} HotCache;
+
+// Cria um cache com pelo menos 'slots' posições (arredondado para potência de 2).
+HotCache* hot_cache_create(int slots);
+
+// Procura a palavra no cache. Retorna 1 e preenche *out em caso de acerto.
+int hot_cache_lookup(HotCache *cache, const char *word, IndexEntry *out);
+
+// Guarda o resultado de uma busca, substituindo o que houver na posição.
+void hot_cache_store(HotCache *cache, const IndexEntry *entry);
+
+// Esvazia o cache (necessário quando o índice muda e os ponteiros deixam de valer).
+// Os contadores de acertos e falhas são mantidos.
+void hot_cache_clear(HotCache *cache);
+
+// Libera o cache.
+void hot_cache_free(HotCache *cache);
+
+#endif // HOT_CACHE_H
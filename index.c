@@ -0,0 +1,478 @@
+#include "index.h"
+#include "hot_cache.h"
+#include "bloom.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+// Nomes exibidos para cada backend
+static const char *INDEX_NAMES[INDEX_NUM_TYPES] = {
+    "Vetor (pesquisa binaria)",
+    "Arvore Binaria de Busca",
+    "Arvore AVL",
+    "Arvore Splay",
+    "Skip list concorrente"
+};
+
+static const char *INDEX_SHORT_NAMES[INDEX_NUM_TYPES] = {
+    "Vetor",
+    "BST",
+    "AVL",
+    "Splay",
+    "SkipList"
+};
+
+// Nomes aceitos na escolha de backends (ver index_parse_mask)
+static const char *INDEX_KEYS[INDEX_NUM_TYPES] = {
+    "vetor",
+    "bst",
+    "avl",
+    "splay",
+    "skiplist"
+};
+
+// Converte uma entrada do vetor para a visão comum
+static void fromWordEntry(const WordEntry *e, IndexEntry *out) {
+    out->word = e->word;
+    out->frequency = e->frequency;
+    out->docs = e->docs;
+    out->count_docs = e->count_docs;
+    out->bitmap = e->bitmap;
+}
+
+// Converte um nó da BST para a visão comum
+static void fromBSTNode(const BSTNode *n, IndexEntry *out) {
+    out->word = n->postings->word;
+    out->frequency = n->postings->frequency;
+    out->docs = postings_docs(n->postings);
+    out->count_docs = n->postings->count;
+    out->bitmap = postings_bitmap(n->postings);
+}
+
+// Converte um nó da AVL para a visão comum
+static void fromAVLNode(const AVLNode *n, IndexEntry *out) {
+    out->word = n->postings->word;
+    out->frequency = n->postings->frequency;
+    out->docs = postings_docs(n->postings);
+    out->count_docs = n->postings->count;
+    out->bitmap = postings_bitmap(n->postings);
+}
+
+// Converte um nó da árvore splay para a visão comum
+static void fromSplayNode(const SplayNode *n, IndexEntry *out) {
+    out->word = n->postings->word;
+    out->frequency = n->postings->frequency;
+    out->docs = postings_docs(n->postings);
+    out->count_docs = n->postings->count;
+    out->bitmap = postings_bitmap(n->postings);
+}
+
+// Converte um nó da skip list (já concluída) para a visão comum
+static void fromSkipNode(const SkipNode *n, IndexEntry *out) {
+    out->word = n->word;
+    out->frequency = n->frequency;
+    out->docs = n->docs;
+    out->count_docs = n->count_docs;
+    out->bitmap = n->bitmap;
+}
+
+// Acesso aos nós de uma das árvores (BST, AVL ou splay) para o percurso em ordem
+typedef struct {
+    const void* (*left)(const void *node);
+    const void* (*right)(const void *node);
+    void (*entry)(const void *node, IndexEntry *out);
+} TreeWalk;
+
+static const void* bstLeft(const void *n) { return ((const BSTNode *)n)->left; }
+static const void* bstRight(const void *n) { return ((const BSTNode *)n)->right; }
+static void bstEntry(const void *n, IndexEntry *out) { fromBSTNode((const BSTNode *)n, out); }
+static const void* avlLeft(const void *n) { return ((const AVLNode *)n)->left; }
+static const void* avlRight(const void *n) { return ((const AVLNode *)n)->right; }
+static void avlEntry(const void *n, IndexEntry *out) { fromAVLNode((const AVLNode *)n, out); }
+static const void* splayLeft(const void *n) { return ((const SplayNode *)n)->left; }
+static const void* splayRight(const void *n) { return ((const SplayNode *)n)->right; }
+static void splayEntry(const void *n, IndexEntry *out) { fromSplayNode((const SplayNode *)n, out); }
+
+static const TreeWalk BST_WALK = {bstLeft, bstRight, bstEntry};
+static const TreeWalk AVL_WALK = {avlLeft, avlRight, avlEntry};
+static const TreeWalk SPLAY_WALK = {splayLeft, splayRight, splayEntry};
+
+// Percurso em ordem de uma árvore (não altera a árvore). É iterativo, com pilha
+// explícita: a profundidade da BST e da árvore splay não é limitada (inserções em ordem
+// crescente formam um caminho com todos os nós) e a recursão estouraria a pilha.
+static void treeInorder(const void *root, const TreeWalk *walk, IndexVisitFn visit, void *ctx) {
+    int capacity = 64, top = 0;
+    const void **stack = (const void **)malloc(capacity * sizeof(const void *));
+    if (stack == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o percurso da arvore.\n");
+        exit(EXIT_FAILURE);
+    }
+    const void *node = root;
+    while (node != NULL || top > 0) {
+        while (node != NULL) {
+            if (top == capacity) {
+                capacity *= 2;
+                stack = (const void **)realloc(stack, capacity * sizeof(const void *));
+                if (stack == NULL) {
+                    fprintf(stderr, "Erro ao realocar memória para o percurso da arvore.\n");
+                    exit(EXIT_FAILURE);
+                }
+            }
+            stack[top++] = node;
+            node = walk->left(node);
+        }
+        node = stack[--top];
+        IndexEntry e;
+        walk->entry(node, &e);
+        visit(&e, ctx);
+        node = walk->right(node);
+    }
+    free(stack);
+}
+
+void index_init(Index *idx, IndexType type) {
+    idx->type = type;
+    idx->cache = NULL;
+    idx->bloom = NULL;
+    switch (type) {
+        case INDEX_VECTOR:
+            initVector(&idx->data.vector);
+            break;
+        case INDEX_BST:
+            idx->data.bst = NULL;
+            tree_pool_init(&idx->pool);
+            break;
+        case INDEX_AVL:
+            idx->data.avl = NULL;
+            tree_pool_init(&idx->pool);
+            break;
+        case INDEX_SPLAY:
+            idx->data.splay = NULL;
+            tree_pool_init(&idx->pool);
+            break;
+        case INDEX_SKIPLIST:
+            skiplist_init(&idx->data.skiplist, INDEX_SKIPLIST_WRITERS);
+            break;
+        default:
+            fprintf(stderr, "Tipo de indice invalido: %d.\n", (int)type);
+            exit(EXIT_FAILURE);
+    }
+}
+
+void index_insert(Index *idx, const char *word, uint32_t doc) {
+    if (idx->cache != NULL)
+        hot_cache_clear(idx->cache);
+    // Uma palavra que liga bits novos certamente é nova. Uma palavra nova cujos bits já
+    // estavam todos ligados não é contada, o que é tão raro quanto um falso positivo.
+    if (idx->bloom != NULL && bloom_add(idx->bloom, word))
+        idx->bloom->keys++;
+    switch (idx->type) {
+        case INDEX_VECTOR:
+            vector_insert(&idx->data.vector, word, doc);
+            break;
+        case INDEX_BST:
+            idx->data.bst = bst_insert(idx->data.bst, word, doc, &idx->pool);
+            break;
+        case INDEX_AVL:
+            idx->data.avl = avl_insert(idx->data.avl, word, doc, &idx->pool);
+            break;
+        case INDEX_SPLAY:
+            idx->data.splay = splay_insert(idx->data.splay, word, doc, &idx->pool);
+            break;
+        case INDEX_SKIPLIST:
+            skiplist_insert(&idx->data.skiplist, 0, word, doc);
+            break;
+        default:
+            break;
+    }
+}
+
+void index_finish_load(Index *idx) {
+    switch (idx->type) {
+        case INDEX_VECTOR:
+            vector_freeze(&idx->data.vector);
+            break;
+        case INDEX_SKIPLIST:
+            skiplist_finish(&idx->data.skiplist);
+            break;
+        default:
+            break;
+    }
+}
+
+// Pesquisa a palavra diretamente na estrutura
+static int searchStructure(Index *idx, const char *word, IndexEntry *out) {
+    switch (idx->type) {
+        case INDEX_VECTOR: {
+            WordEntry *e = vector_search_entry(&idx->data.vector, word);
+            if (e == NULL)
+                return 0;
+            fromWordEntry(e, out);
+            return 1;
+        }
+        case INDEX_BST: {
+            BSTNode *n = bst_search(idx->data.bst, word);
+            if (n == NULL)
+                return 0;
+            fromBSTNode(n, out);
+            return 1;
+        }
+        case INDEX_AVL: {
+            AVLNode *n = avl_search(idx->data.avl, word);
+            if (n == NULL)
+                return 0;
+            fromAVLNode(n, out);
+            return 1;
+        }
+        case INDEX_SPLAY: {
+            SplayNode *n = splay_search(&idx->data.splay, word);
+            if (n == NULL)
+                return 0;
+            fromSplayNode(n, out);
+            return 1;
+        }
+        case INDEX_SKIPLIST: {
+            SkipNode *n = skiplist_search(&idx->data.skiplist, word);
+            if (n == NULL)
+                return 0;
+            fromSkipNode(n, out);
+            return 1;
+        }
+        default:
+            return 0;
+    }
+}
+
+int index_search(Index *idx, const char *word, IndexEntry *out) {
+    if (idx->bloom != NULL && !bloom_may_contain(idx->bloom, word))
+        return 0;
+    if (idx->cache == NULL)
+        return searchStructure(idx, word, out);
+    if (hot_cache_lookup(idx->cache, word, out))
+        return 1;
+    if (!searchStructure(idx, word, out))
+        return 0;
+    hot_cache_store(idx->cache, out);
+    return 1;
+}
+
+void index_set_cache(Index *idx, int slots) {
+    hot_cache_free(idx->cache);
+    idx->cache = (slots > 0) ? hot_cache_create(slots) : NULL;
+}
+
+// Conta as palavras do índice (usado para dimensionar o filtro)
+static void countWord(const IndexEntry *entry, void *ctx) {
+    (void)entry;
+    (*(uint32_t *)ctx)++;
+}
+
+// Adiciona cada palavra do índice ao filtro
+static void addWord(const IndexEntry *entry, void *ctx) {
+    bloom_add((BloomFilter *)ctx, entry->word);
+}
+
+void index_set_bloom(Index *idx, int bits_per_key) {
+    bloom_free(idx->bloom);
+    idx->bloom = NULL;
+    if (bits_per_key <= 0)
+        return;
+    uint32_t words = 0;
+    index_foreach(idx, countWord, &words);
+    BloomFilter *bloom = bloom_create(words, bits_per_key);
+    index_foreach(idx, addWord, bloom);
+    bloom->keys = words; // Palavras distintas do índice
+    idx->bloom = bloom;
+}
+
+void index_foreach(Index *idx, IndexVisitFn visit, void *ctx) {
+    switch (idx->type) {
+        case INDEX_VECTOR: {
+            // Congelado, o vetor guarda as entradas na ordem da hash: a ordem alfabética
+            // é montada só para o percurso
+            WordEntry **ordem = vector_sorted_entries(&idx->data.vector);
+            for (int i = 0; i < idx->data.vector.size; i++) {
+                IndexEntry e;
+                fromWordEntry(ordem[i], &e);
+                visit(&e, ctx);
+            }
+            free(ordem);
+            break;
+        }
+        case INDEX_BST:
+            treeInorder(idx->data.bst, &BST_WALK, visit, ctx);
+            break;
+        case INDEX_AVL:
+            treeInorder(idx->data.avl, &AVL_WALK, visit, ctx);
+            break;
+        case INDEX_SPLAY:
+            treeInorder(idx->data.splay, &SPLAY_WALK, visit, ctx);
+            break;
+        case INDEX_SKIPLIST:
+            for (SkipNode *n = idx->data.skiplist.head->next[0]; n != NULL; n = n->next[0]) {
+                IndexEntry e;
+                fromSkipNode(n, &e);
+                visit(&e, ctx);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void index_entry_foreach_doc(const IndexEntry *entry, IndexDocFn fn, void *ctx) {
+    if (entry->bitmap != NULL) {
+        roaring_foreach(entry->bitmap, fn, ctx);
+        return;
+    }
+    for (int i = 0; i < entry->count_docs; i++)
+        fn(entry->docs[i], ctx);
+}
+
+int index_entry_contains(const IndexEntry *entry, uint32_t doc) {
+    if (entry->bitmap != NULL)
+        return roaring_contains(entry->bitmap, doc);
+    int low = 0, high = entry->count_docs;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (entry->docs[mid] < doc)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low < entry->count_docs && entry->docs[low] == doc;
+}
+
+uint32_t index_intersect_count(const IndexEntry *a, const IndexEntry *b) {
+    if (a->bitmap != NULL && b->bitmap != NULL)
+        return roaring_and_cardinality(a->bitmap, b->bitmap);
+    // Garante que a seja a lista (o vetor percorrido) quando só um for compactado
+    if (a->bitmap != NULL) {
+        const IndexEntry *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    uint32_t total = 0;
+    if (b->bitmap != NULL) {
+        for (int i = 0; i < a->count_docs; i++)
+            total += roaring_contains(b->bitmap, a->docs[i]);
+        return total;
+    }
+    // Dois vetores ordenados: intercalação
+    int i = 0, j = 0;
+    while (i < a->count_docs && j < b->count_docs) {
+        if (a->docs[i] < b->docs[j]) {
+            i++;
+        } else if (a->docs[i] > b->docs[j]) {
+            j++;
+        } else {
+            total++;
+            i++;
+            j++;
+        }
+    }
+    return total;
+}
+
+// Estado da interseção: candidatos vindos da palavra mais rara
+typedef struct {
+    const IndexEntry *entries;
+    int n;
+    int menor;
+    uint32_t *out;
+    int count;
+} IntersectState;
+
+// Mantém o documento da palavra mais rara se ele estiver em todas as outras
+static void filterDoc(uint32_t doc, void *ctx) {
+    IntersectState *it = (IntersectState *)ctx;
+    for (int i = 0; i < it->n; i++) {
+        if (i != it->menor && !index_entry_contains(&it->entries[i], doc))
+            return;
+    }
+    it->out[it->count++] = doc;
+}
+
+int index_intersect(const IndexEntry *entries, int n, uint32_t *out) {
+    if (n <= 0)
+        return 0;
+    IntersectState it = {entries, n, 0, out, 0};
+    for (int i = 1; i < n; i++) {
+        if (entries[i].count_docs < entries[it.menor].count_docs)
+            it.menor = i;
+    }
+    index_entry_foreach_doc(&entries[it.menor], filterDoc, &it);
+    return it.count;
+}
+
+size_t index_entry_doc_memory(const IndexEntry *entry) {
+    if (entry->bitmap != NULL)
+        return roaring_memory(entry->bitmap);
+    return entry->count_docs * sizeof(uint32_t);
+}
+
+void index_free(Index *idx) {
+    hot_cache_free(idx->cache);
+    idx->cache = NULL;
+    bloom_free(idx->bloom);
+    idx->bloom = NULL;
+    switch (idx->type) {
+        case INDEX_VECTOR:
+            freeVector(&idx->data.vector);
+            break;
+        case INDEX_BST:
+            bst_free(&idx->pool);
+            idx->data.bst = NULL;
+            break;
+        case INDEX_AVL:
+            avl_free(&idx->pool);
+            idx->data.avl = NULL;
+            break;
+        case INDEX_SPLAY:
+            splay_free(&idx->pool);
+            idx->data.splay = NULL;
+            break;
+        case INDEX_SKIPLIST:
+            skiplist_free(&idx->data.skiplist);
+            break;
+        default:
+            break;
+    }
+}
+
+const char* index_name(IndexType type) {
+    return (type >= 0 && type < INDEX_NUM_TYPES) ? INDEX_NAMES[type] : "?";
+}
+
+const char* index_short_name(IndexType type) {
+    return (type >= 0 && type < INDEX_NUM_TYPES) ? INDEX_SHORT_NAMES[type] : "?";
+}
+
+unsigned int index_parse_mask(const char *spec) {
+    unsigned int mask = 0;
+    char buffer[128];
+    strncpy(buffer, spec, sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+    for (int i = 0; buffer[i]; i++)
+        buffer[i] = tolower((unsigned char)buffer[i]);
+
+    char *token = strtok(buffer, ", \t");
+    while (token != NULL) {
+        if (strcmp(token, "todas") == 0) {
+            mask |= INDEX_MASK_ALL;
+        } else {
+            int t;
+            for (t = 0; t < INDEX_NUM_TYPES; t++) {
+                if (strcmp(token, INDEX_KEYS[t]) == 0)
+                    break;
+            }
+            if (t == INDEX_NUM_TYPES)
+                return 0;
+            mask |= INDEX_MASK(t);
+        }
+        token = strtok(NULL, ", \t");
+    }
+    return mask;
+}
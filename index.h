@@ -0,0 +1,118 @@
+#ifndef INDEX_H
+#define INDEX_H
+
+#include "vector.h"
+#include "bst.h"
+#include "avl.h"
+#include "splay.h"
+#include "skiplist.h"
+
+// Tipos de estrutura (backends) que podem ser usados como índice de palavras.
+typedef enum {
+    INDEX_VECTOR = 0,    // Vetor ordenado com busca binária
+    INDEX_BST,           // Árvore Binária de Busca (não balanceada)
+    INDEX_AVL,           // Árvore AVL
+    INDEX_SPLAY,         // Árvore Splay (auto-ajustável aos acessos)
+    INDEX_SKIPLIST,      // Skip list lock-free (carga paralela)
+    INDEX_NUM_TYPES      // Quantidade de tipos (não é um backend)
+} IndexType;
+
+// Quantidade de threads escritoras aceitas pela skip list de um índice
+#define INDEX_SKIPLIST_WRITERS 64
+
+// Máscara de bits usada para escolher quais backends serão construídos.
+#define INDEX_MASK(type) (1u << (type))
+#define INDEX_MASK_ALL   ((1u << INDEX_NUM_TYPES) - 1)
+
+// Visão comum de uma palavra indexada, independente do backend que a armazena.
+// Os ponteiros referenciam a memória da própria estrutura (não devem ser liberados).
+// Os documentos (IDs de linha, ver doc_table.h) estão em ordem crescente e sem repetição,
+// em docs ou, para palavras comuns, no conjunto compactado bitmap (o outro fica NULL).
+typedef struct {
+    const char *word;        // Palavra armazenada
+    int frequency;           // Frequência da palavra
+    const uint32_t *docs;    // Documentos onde a palavra ocorre (NULL se bitmap)
+    int count_docs;          // Quantidade de documentos
+    const Roaring *bitmap;   // Documentos compactados (NULL se docs)
+} IndexEntry;
+
+// Função chamada para cada palavra durante a iteração (em ordem alfabética).
+typedef void (*IndexVisitFn)(const IndexEntry *entry, void *ctx);
+
+// Função chamada para cada documento de uma palavra (em ordem crescente).
+typedef void (*IndexDocFn)(uint32_t doc, void *ctx);
+
+// Índice de palavras: encapsula um dos backends atrás de uma interface única.
+typedef struct {
+    IndexType type;          // Backend utilizado
+    union {
+        Vector vector;
+        BSTNode *bst;
+        AVLNode *avl;
+        SplayNode *splay;
+        SkipList skiplist;
+    } data;
+    TreePool pool;           // Pool de nós (usado apenas pelos backends em árvore)
+    struct HotCache *cache;  // Cache opcional de termos frequentes (NULL = desativado)
+    struct BloomFilter *bloom; // Filtro opcional de palavras ausentes (NULL = desativado)
+} Index;
+
+// Inicializa um índice vazio do tipo informado.
+void index_init(Index *idx, IndexType type);
+
+// Insere uma ocorrência da palavra no documento informado. Os documentos devem chegar
+// em ordem crescente (a ordem das linhas do arquivo).
+void index_insert(Index *idx, const char *word, uint32_t doc);
+
+// Conclui a carga do índice. Deve ser chamada depois da última inserção e antes das
+// buscas (a skip list junta aqui os documentos gravados pelas threads e o vetor congela
+// o vocabulário em uma hash perfeita).
+void index_finish_load(Index *idx);
+
+// Pesquisa a palavra. Retorna 1 e preenche *out se encontrada, 0 caso contrário.
+// Se o filtro de Bloom estiver ativo, palavras ausentes são rejeitadas por ele antes
+// de qualquer acesso à estrutura; depois vem o cache, se estiver ativo.
+int index_search(Index *idx, const char *word, IndexEntry *out);
+
+// Ativa um cache de termos frequentes com o número de posições informado na frente
+// da busca (0 desativa). Inserções esvaziam o cache, pois invalidam os resultados.
+void index_set_cache(Index *idx, int slots);
+
+// Constrói um filtro de Bloom com as palavras atuais do índice ('bits_per_key' bits por
+// palavra; 0 desativa). Inserções posteriores também são adicionadas ao filtro.
+void index_set_bloom(Index *idx, int bits_per_key);
+
+// Percorre todas as palavras do índice em ordem alfabética.
+void index_foreach(Index *idx, IndexVisitFn visit, void *ctx);
+
+// Percorre os documentos de uma palavra em ordem crescente.
+void index_entry_foreach_doc(const IndexEntry *entry, IndexDocFn fn, void *ctx);
+
+// Retorna 1 se a palavra ocorre no documento.
+int index_entry_contains(const IndexEntry *entry, uint32_t doc);
+
+// Quantidade de documentos com as duas palavras (sem montar a interseção). Dois
+// conjuntos compactados são cruzados com AND de palavras de 64 bits.
+uint32_t index_intersect_count(const IndexEntry *a, const IndexEntry *b);
+
+// Documentos que contêm todas as 'n' palavras, gravados em out (que deve ter espaço para
+// os documentos da palavra mais rara). Retorna a quantidade gravada.
+int index_intersect(const IndexEntry *entries, int n, uint32_t *out);
+
+// Memória ocupada pelas listas de documentos de uma palavra, em bytes.
+size_t index_entry_doc_memory(const IndexEntry *entry);
+
+// Libera a memória do índice.
+void index_free(Index *idx);
+
+// Nome legível do backend (usado nas mensagens de tempo).
+const char* index_name(IndexType type);
+
+// Nome curto do backend (usado como prefixo nos resultados, ex: "[AVL]").
+const char* index_short_name(IndexType type);
+
+// Interpreta uma lista de backends separados por vírgula (ex: "vetor,avl" ou "todas")
+// e retorna a máscara correspondente, ou 0 se algum nome for inválido.
+unsigned int index_parse_mask(const char *spec);
+
+#endif // INDEX_H
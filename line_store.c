@@ -0,0 +1,46 @@
+#include "line_store.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Capacidade inicial do vetor de linhas
+#define INITIAL_LINE_CAPACITY 1024
+
+void line_store_init(LineStore *store) {
+    pool_init(&store->text, POOL_SLAB_SIZE);
+    store->lines = NULL;
+    store->count = 0;
+    store->capacity = 0;
+    store->bytes = 0;
+}
+
+uint32_t line_store_add(LineStore *store, const char *text, size_t len) {
+    if (store->count >= store->capacity) {
+        store->capacity = (store->capacity == 0) ? INITIAL_LINE_CAPACITY : store->capacity * 2;
+        store->lines = realloc(store->lines, store->capacity * sizeof(const char *));
+        if (store->lines == NULL) {
+            fprintf(stderr, "Erro ao realocar memória para as linhas retidas.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    char *copy = (char *)pool_alloc(&store->text, len + 1);
+    memcpy(copy, text, len);
+    copy[len] = '\0';
+    store->lines[store->count] = copy;
+    store->bytes += len + 1;
+    return store->count++;
+}
+
+size_t line_store_memory(const LineStore *store) {
+    return pool_memory(&store->text) + store->capacity * sizeof(const char *);
+}
+
+void line_store_free(LineStore *store) {
+    pool_destroy(&store->text);
+    free(store->lines);
+    store->lines = NULL;
+    store->count = 0;
+    store->capacity = 0;
+    store->bytes = 0;
+}
@@ -0,0 +1,36 @@
+#ifndef LINE_STORE_H
+#define LINE_STORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "pool.h"
+
+// Linhas retidas na memória durante uma carga em fluxo (entrada padrão ou arquivo
+// compactado), em que não há um arquivo para reabrir com fseek na hora de exibir as
+// citações. O ID de cada linha é o mesmo ID de documento usado pelos índices.
+typedef struct {
+    Pool text;               // Texto das linhas (sem o '\n'), terminado em '\0'
+    const char **lines;      // Texto de cada documento
+    uint32_t count;          // Quantidade de linhas
+    uint32_t capacity;       // Capacidade atual do vetor de linhas
+    size_t bytes;            // Bytes de texto guardados
+} LineStore;
+
+// Inicializa um repositório vazio.
+void line_store_init(LineStore *store);
+
+// Copia a linha (len bytes, sem o '\n') e retorna seu ID.
+uint32_t line_store_add(LineStore *store, const char *text, size_t len);
+
+// Texto da linha do documento.
+static inline const char* line_store_get(const LineStore *store, uint32_t doc) {
+    return store->lines[doc];
+}
+
+// Memória ocupada pelo repositório (texto e vetor de linhas), em bytes.
+size_t line_store_memory(const LineStore *store);
+
+// Libera o repositório (ele pode ser preenchido de novo depois de line_store_init).
+void line_store_free(LineStore *store);
+
+#endif // LINE_STORE_H
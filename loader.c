@@ -0,0 +1,262 @@
+#define _GNU_SOURCE
+#include "loader.h"
+#include "hot_cache.h"
+#include "tokenizer.h"
+#include "parallel_load.h"
+#include "batch_search.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Ordem de preferência das estruturas: a skip list é a mais rápida de construir (carga
+// paralela) e o vetor a mais lenta (deslocamentos a cada palavra nova)
+static const IndexType LOAD_ORDER[INDEX_NUM_TYPES] = {
+    INDEX_SKIPLIST, INDEX_AVL, INDEX_BST, INDEX_SPLAY, INDEX_VECTOR
+};
+
+double load_wall_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+IndexType load_primary(unsigned int estruturas) {
+    for (int i = 0; i < INDEX_NUM_TYPES; i++) {
+        if (estruturas & INDEX_MASK(LOAD_ORDER[i]))
+            return LOAD_ORDER[i];
+    }
+    return INDEX_NUM_TYPES;
+}
+
+// Estado da carga compartilhado com inserirPalavra
+typedef struct {
+    Index *indices;
+    unsigned int estruturas;
+    double *tempos;
+} Carga;
+
+// Insere uma palavra em cada estrutura selecionada, cronometrando cada uma
+static void inserirPalavra(const char *token, uint32_t doc, void *ctx) {
+    Carga *carga = (Carga *)ctx;
+    clock_t inicio, fim;
+    for (int t = 0; t < INDEX_NUM_TYPES; t++) {
+        if (!(carga->estruturas & INDEX_MASK(t)))
+            continue;
+        inicio = clock();
+        index_insert(&carga->indices[t], token, doc);
+        fim = clock();
+        carga->tempos[t] += ((double)(fim - inicio)) / CLOCKS_PER_SEC;
+    }
+}
+
+// Libera as estruturas da máscara depois de uma falha na carga
+static void liberarCarga(Index indices[], unsigned int estruturas) {
+    for (int t = 0; t < INDEX_NUM_TYPES; t++) {
+        if (estruturas & INDEX_MASK(t))
+            index_free(&indices[t]);
+    }
+}
+
+// Conclui a carga das estruturas da máscara (index_finish_load), medindo o vetor
+static void concluirCarga(Index indices[], unsigned int estruturas, LoadStats *stats) {
+    for (int t = 0; t < INDEX_NUM_TYPES; t++) {
+        if (!(estruturas & INDEX_MASK(t)))
+            continue;
+        double inicio = load_wall_time();
+        index_finish_load(&indices[t]);
+        if (t == INDEX_VECTOR)
+            stats->congelamento = load_wall_time() - inicio;
+    }
+}
+
+int load_indices(const char *arquivo, Index indices[], unsigned int estruturas,
+                 DocTable *docs, LoadStats *stats) {
+    memset(stats, 0, sizeof(LoadStats));
+    FILE *fp = fopen(arquivo, "r");
+    if (fp == NULL) {
+        fprintf(stderr, "Erro ao abrir o arquivo %s.\n", arquivo);
+        return 0;
+    }
+
+    // Pula o BOM UTF-8 se existir
+    unsigned char bom[3];
+    if (fread(bom, 1, 3, fp) == 3) {
+        if (!(bom[0] == 0xEF && bom[1] == 0xBB && bom[2] == 0xBF)) {
+            fseek(fp, 0, SEEK_SET);
+        }
+    } else {
+        fseek(fp, 0, SEEK_SET);
+    }
+
+    char linha[MAX_LINE];
+    uint32_t doc = 0;
+    // A skip list é preenchida à parte, por várias threads; as demais estruturas
+    // são preenchidas na leitura sequencial
+    unsigned int sequenciais = estruturas & ~INDEX_MASK(INDEX_SKIPLIST);
+    // Sem tabela de documentos a leitura sequencial numera as linhas; se só a skip list
+    // foi escolhida, não há leitura sequencial e as threads numeram as linhas sozinhas
+    bool numerar = (docs->count == 0 && sequenciais != 0);
+    Carga carga = {indices, sequenciais, stats->tempos};
+
+    for (int t = 0; t < INDEX_NUM_TYPES; t++) {
+        if (estruturas & INDEX_MASK(t))
+            index_init(&indices[t], (IndexType)t);
+    }
+
+    // Linhas maiores que MAX_LINE são lidas em pedaços, mas formam um único documento,
+    // como na carga em fluxo
+    int fimLinha = 1;
+    while (sequenciais != 0) {
+        long offset = ftell(fp); // Posição do pedaço no arquivo
+        int inicioLinha = fimLinha;
+        if (!read_line_chunk(fp, linha, &fimLinha))
+            break;
+        if (numerar && inicioLinha)
+            doc = doc_table_add(docs, offset);
+        linha[strcspn(linha, "\r\n")] = '\0';
+        tokenize_line(linha, doc, inserirPalavra, &carga);
+        if (fimLinha)
+            doc++;
+    }
+    fclose(fp);
+
+    if (estruturas & INDEX_MASK(INDEX_SKIPLIST)) {
+        stats->threads = batch_default_threads();
+        double inicio = load_wall_time();
+        int ok = parallel_load_skiplist(arquivo, &indices[INDEX_SKIPLIST].data.skiplist,
+                                        stats->threads, docs);
+        stats->tempos[INDEX_SKIPLIST] = load_wall_time() - inicio;
+        if (!ok) {
+            liberarCarga(indices, estruturas);
+            return 0;
+        }
+    }
+
+    concluirCarga(indices, estruturas, stats);
+    return 1;
+}
+
+// Estado da carga em fluxo: a carga comum e o repositório das linhas lidas
+typedef struct {
+    Carga carga;
+    LineStore *linhas;
+} CargaFluxo;
+
+// Guarda a linha recebida da leitura em fluxo e indexa suas palavras
+static void indexarLinha(char *linha, size_t len, void *ctx) {
+    CargaFluxo *fluxo = (CargaFluxo *)ctx;
+    uint32_t doc = line_store_add(fluxo->linhas, linha, len);
+    if (fluxo->carga.estruturas == 0)
+        return;
+    if (len < MAX_LINE) {
+        tokenize_line(linha, doc, inserirPalavra, &fluxo->carga);
+        return;
+    }
+    // Linhas longas são indexadas em pedaços de MAX_LINE - 1 bytes, como na leitura
+    // com fgets, mas todos os pedaços pertencem ao mesmo documento
+    char pedaco[MAX_LINE];
+    for (size_t i = 0; i < len; i += MAX_LINE - 1) {
+        size_t n = (len - i < MAX_LINE - 1) ? len - i : MAX_LINE - 1;
+        memcpy(pedaco, linha + i, n);
+        pedaco[n] = '\0';
+        tokenize_line(pedaco, doc, inserirPalavra, &fluxo->carga);
+    }
+}
+
+int load_indices_stream(StreamSource *fonte, Index indices[], unsigned int estruturas,
+                        LineStore *linhas, LoadStats *stats, StreamStats *leitura) {
+    memset(stats, 0, sizeof(LoadStats));
+    for (int t = 0; t < INDEX_NUM_TYPES; t++) {
+        if (estruturas & INDEX_MASK(t))
+            index_init(&indices[t], (IndexType)t);
+    }
+    // Sem várias passadas pelo arquivo, a skip list também é preenchida pelo indexador
+    CargaFluxo fluxo = {{indices, estruturas, stats->tempos}, linhas};
+    if (estruturas & INDEX_MASK(INDEX_SKIPLIST))
+        stats->threads = 1;
+    if (!stream_read_lines(fonte, indexarLinha, &fluxo, leitura)) {
+        liberarCarga(indices, estruturas);
+        return 0;
+    }
+    concluirCarga(indices, estruturas, stats);
+    return 1;
+}
+
+// Corpo da thread de segundo plano: constrói uma estrutura de cada vez e a publica
+static void* construirEmSegundoPlano(void *arg) {
+    BackgroundLoad *bg = (BackgroundLoad *)arg;
+    double inicio = load_wall_time();
+    for (int i = 0; i < INDEX_NUM_TYPES; i++) {
+        IndexType t = LOAD_ORDER[i];
+        if (!(bg->pendentes & INDEX_MASK(t)))
+            continue;
+        LoadStats stats;
+        if (!load_indices(bg->arquivo, bg->indices, INDEX_MASK(t), bg->docs, &stats)) {
+            bg->falhas |= INDEX_MASK(t);
+            continue;
+        }
+        bg->stats.tempos[t] = stats.tempos[t];
+        if (t == INDEX_SKIPLIST)
+            bg->stats.threads = stats.threads;
+        if (t == INDEX_VECTOR)
+            bg->stats.congelamento = stats.congelamento;
+        index_set_cache(&bg->indices[t], bg->cacheSlots);
+        index_set_bloom(&bg->indices[t], bg->bloomBits);
+
+        // A árvore de frequência é montada enquanto a primeira estrutura ainda é só
+        // desta thread (a árvore splay, por exemplo, muda a cada busca depois de publicada)
+        if (bg->construirFrequencia && !bg->frequenciaPronta) {
+            freq_index_build(&bg->frequencia, &bg->indices[t]);
+            __atomic_store_n(&bg->frequenciaPronta, 1, __ATOMIC_RELEASE);
+        }
+        bg->prontaEm[t] = load_wall_time() - inicio;
+        __atomic_or_fetch(&bg->prontas, INDEX_MASK(t), __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+void background_load_start(BackgroundLoad *bg, const char *arquivo, Index indices[],
+                           DocTable *docs, unsigned int estruturas, int cacheSlots,
+                           int bloomBits, bool frequencia) {
+    memset(bg, 0, sizeof(BackgroundLoad));
+    strncpy(bg->arquivo, arquivo, sizeof(bg->arquivo) - 1);
+    bg->indices = indices;
+    bg->docs = docs;
+    bg->pendentes = estruturas;
+    bg->cacheSlots = cacheSlots;
+    bg->bloomBits = bloomBits;
+    bg->construirFrequencia = frequencia;
+    if (estruturas == 0)
+        return;
+    if (pthread_create(&bg->thread, NULL, construirEmSegundoPlano, bg) != 0) {
+        fprintf(stderr, "Erro ao criar a thread de carga em segundo plano.\n");
+        exit(EXIT_FAILURE);
+    }
+    bg->ativa = true;
+}
+
+unsigned int background_load_ready(BackgroundLoad *bg) {
+    return __atomic_load_n(&bg->prontas, __ATOMIC_ACQUIRE);
+}
+
+int background_load_frequency_ready(BackgroundLoad *bg) {
+    return __atomic_load_n(&bg->frequenciaPronta, __ATOMIC_ACQUIRE);
+}
+
+void background_load_wait(BackgroundLoad *bg) {
+    if (!bg->ativa)
+        return;
+    pthread_join(bg->thread, NULL);
+    bg->ativa = false;
+}
+
+void background_load_free(BackgroundLoad *bg) {
+    background_load_wait(bg);
+    if (bg->frequenciaPronta)
+        freq_index_free(&bg->frequencia);
+    bg->frequenciaPronta = 0;
+    bg->prontas = 0;
+    bg->pendentes = 0;
+}
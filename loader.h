@@ -0,0 +1,88 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include <pthread.h>
+#include <stdbool.h>
+
+#include "index.h"
+#include "frequency_avl.h"
+#include "doc_table.h"
+#include "line_store.h"
+#include "stream.h"
+
+// Tempos medidos durante a carga de um conjunto de índices.
+typedef struct {
+    double tempos[INDEX_NUM_TYPES];  // Tempo de inserção de cada estrutura (segundos)
+    double congelamento;             // Tempo de index_finish_load do vetor (hash perfeita)
+    int threads;                     // Threads usadas pela skip list (0 se não construída)
+} LoadStats;
+
+// Construção das estruturas secundárias em uma thread de segundo plano. A thread
+// constrói uma estrutura de cada vez e só a publica em 'prontas' depois de concluída
+// (com cache e filtro de Bloom já configurados); até lá a thread principal não deve
+// tocar nela. Estruturas publicadas passam a pertencer à thread principal.
+typedef struct {
+    pthread_t thread;
+    bool ativa;                      // Thread criada e ainda não aguardada
+    char arquivo[256];               // Arquivo de citações
+    Index *indices;                  // Vetor de índices (um por IndexType)
+    DocTable *docs;                  // Tabela de documentos (já preenchida; só leitura)
+    unsigned int pendentes;          // Estruturas construídas pela thread
+    unsigned int prontas;            // Estruturas já publicadas (acesso atômico)
+    int cacheSlots;                  // Configuração aplicada antes da publicação
+    int bloomBits;
+    bool construirFrequencia;        // Se a thread também constrói a árvore de frequência
+    FreqIndex frequencia;            // Árvore de frequência construída pela thread
+    int frequenciaPronta;            // 1 quando 'frequencia' foi publicada (acesso atômico)
+    LoadStats stats;                 // Tempos de inserção de cada estrutura
+    double prontaEm[INDEX_NUM_TYPES];  // Tempo desde o início até a publicação
+    unsigned int falhas;             // Estruturas que não puderam ser construídas
+} BackgroundLoad;
+
+// Tempo de relógio em segundos (clock() soma o tempo de CPU de todas as threads,
+// o que não serve para medir buscas em paralelo nem a carga em segundo plano).
+double load_wall_time(void);
+
+// Lê o arquivo e constrói as estruturas indicadas pela máscara, inclusive a conclusão
+// (index_finish_load). As estruturas da máscara são inicializadas aqui. Se a tabela de
+// documentos estiver vazia, ela é preenchida nesta leitura (um ID por linha); senão os
+// IDs dela são reaproveitados e o arquivo deve ser o mesmo. Retorna 1 em caso de
+// sucesso; em caso de erro as estruturas são liberadas e retorna 0.
+int load_indices(const char *arquivo, Index indices[], unsigned int estruturas,
+                 DocTable *docs, LoadStats *stats);
+
+// Carga em fluxo: lê a fonte (entrada padrão ou arquivo, compactado ou não) uma única vez,
+// com a thread leitora de stream_read_lines, e constrói todas as estruturas da máscara
+// nessa passada (a skip list inclusive, por um único escritor). Cada linha recebe o
+// próximo ID de 'linhas', onde fica guardada para exibir as citações sem reabrir a fonte.
+// Retorna 1 em caso de sucesso; em caso de erro as estruturas são liberadas e retorna 0.
+int load_indices_stream(StreamSource *fonte, Index indices[], unsigned int estruturas,
+                        LineStore *linhas, LoadStats *stats, StreamStats *leitura);
+
+// Estrutura que fica pronta primeiro entre as da máscara (INDEX_NUM_TYPES se vazia).
+// No modo de carga rápida ela é construída antes do menu; a thread de segundo plano
+// constrói as demais na mesma ordem de preferência.
+IndexType load_primary(unsigned int estruturas);
+
+// Inicia a construção em segundo plano das estruturas da máscara e, se 'frequencia' for
+// verdadeiro, da árvore de frequência (a partir da primeira estrutura construída).
+// A tabela de documentos já deve estar preenchida e não pode mudar até o fim da thread.
+void background_load_start(BackgroundLoad *bg, const char *arquivo, Index indices[],
+                           DocTable *docs, unsigned int estruturas, int cacheSlots,
+                           int bloomBits, bool frequencia);
+
+// Máscara das estruturas já publicadas pela thread.
+unsigned int background_load_ready(BackgroundLoad *bg);
+
+// Retorna 1 se a árvore de frequência já foi publicada pela thread.
+int background_load_frequency_ready(BackgroundLoad *bg);
+
+// Aguarda o fim da thread (se houver). Depois disso todas as estruturas pendentes
+// estão prontas ou marcadas em 'falhas'.
+void background_load_wait(BackgroundLoad *bg);
+
+// Aguarda a thread e libera a árvore de frequência construída por ela. As estruturas
+// publicadas não são liberadas (pertencem à thread principal).
+void background_load_free(BackgroundLoad *bg);
+
+#endif // LOADER_H
@@ -8,314 +8,887 @@
 #include <stdbool.h>
 #include <limits.h>
 
-#include "vector.h"
-#include "bst.h"
-#include "avl.h"
+#include "index.h"
 #include "frequency_avl.h"
-
-#define MAX_LINE 1024
-
-// Converte uma string para minúsculo (para caracteres ASCII)
-// Note: caracteres multibyte (acima de 127) não são alterados.
-void str_to_lower(char *str) {
-    for (int i = 0; str[i]; i++) {
-        if ((unsigned char)str[i] < 128) {
-            str[i] = tolower((unsigned char)str[i]);
-        }
-        // se o caractere for >=128, presumimos que já está em caixa adequada
+#include "hot_cache.h"
+#include "bloom.h"
+#include "query_log.h"
+#include "batch_search.h"
+#include "tokenizer.h"
+#include "loader.h"
+
+#define OPCAO_SAIR 5
+
+// Parâmetros do cache de termos frequentes e do benchmark de consultas
+#define HOT_CACHE_SLOTS 256
+#define ZIPF_QUERIES 200000
+#define ZIPF_EXPONENT 1.0
+#define ZIPF_SEED 42
+
+// Palavras aceitas em uma pesquisa e palavras frequentes cruzadas no benchmark
+#define MAX_TERMOS 8
+#define TOP_FREQUENTES 20
+#define REPETICOES_INTERSECAO 200
+
+//inserção nas estruturas selecionadas (vetor, BST, AVL, splay e skip list)
+
+// Exibe o tempo de inserção de uma estrutura (e da hash perfeita, no caso do vetor)
+static void exibirTempo(Index indices[], IndexType t, const LoadStats *stats) {
+    if (t == INDEX_SKIPLIST)
+        printf("%s (%d threads): %.6f segundos\n", index_name(t), stats->threads, stats->tempos[t]);
+    else
+        printf("%s: %.6f segundos\n", index_name(t), stats->tempos[t]);
+    if (t == INDEX_VECTOR) {
+        Vector *vetor = &indices[INDEX_VECTOR].data.vector;
+        printf("Hash perfeita do vetor: %.6f segundos, %.2f bits por palavra (%d palavras)\n",
+               stats->congelamento, vetor->size > 0 ? (double)vector_hash_bits(vetor) / vetor->size : 0.0,
+               vetor->size);
     }
 }
 
-// Remove pontuação para acabar com erros de leitura
-void remove_punctuation(char *str) {
-    int i = 0, j = 0;
-    while (str[i]) {
-        if ((unsigned char)str[i] < 128) {
-            if (isalnum((unsigned char)str[i]) || isspace((unsigned char)str[i])) {
-                str[j++] = str[i];
-            }
-        } else {
-            str[j++] = str[i];
-        }
-        i++;
+// Libera os índices construídos (indicados pela máscara)
+void liberarEstruturas(Index indices[], unsigned int construidas) {
+    for (int t = 0; t < INDEX_NUM_TYPES; t++) {
+        if (construidas & INDEX_MASK(t))
+            index_free(&indices[t]);
     }
-    str[j] = '\0';
 }
 
-//inserção nas estruturas vector, BST, AVL
+int carregarArquivo(const char *nomeArquivo, Index indices[], unsigned int estruturas,
+                    DocTable *docs) {
+    LoadStats stats;
+    if (!load_indices(nomeArquivo, indices, estruturas, docs, &stats))
+        return 0;
 
+    printf("\n%u documentos (linhas) numerados; tabela de offsets: %.1f KB\n",
+           docs->count, doc_table_memory(docs) / 1024.0);
 
-int carregarArquivo(const char *nomeArquivo, Vector *vetor, BSTNode **bst, AVLNode **avl) {
-    FILE *fp = fopen(nomeArquivo, "r");
-    if (fp == NULL) {
-        fprintf(stderr, "Erro ao abrir o arquivo %s.\n", nomeArquivo);
-        return 0;
+    printf("\nTempo total de insercao:\n");
+    for (int t = 0; t < INDEX_NUM_TYPES; t++) {
+        if (estruturas & INDEX_MASK(t))
+            exibirTempo(indices, (IndexType)t, &stats);
     }
+    return 1;
+}
 
-    // Pula o BOM UTF-8 se existir
-    unsigned char bom[3];
-    if (fread(bom, 1, 3, fp) == 3) {
-        if (!(bom[0] == 0xEF && bom[1] == 0xBB && bom[2] == 0xBF)) {
-            fseek(fp, 0, SEEK_SET);
-        }
-    } else {
-        fseek(fp, 0, SEEK_SET);
+// Carga em fluxo: lê a fonte uma única vez (entrada padrão ou arquivo compactado),
+// construindo todas as estruturas e guardando as linhas para exibir as citações.
+int carregarFluxo(const char *nomeArquivo, StreamSource *entradaPadrao, Index indices[],
+                  unsigned int estruturas, LineStore *linhas) {
+    StreamSource fonte;
+    if (entradaPadrao != NULL)
+        fonte = *entradaPadrao;
+    else if (!stream_open(&fonte, nomeArquivo))
+        return 0;
+    LoadStats stats;
+    StreamStats leitura;
+    int ok = load_indices_stream(&fonte, indices, estruturas, linhas, &stats, &leitura);
+    if (!stream_close(&fonte) && ok) {
+        liberarEstruturas(indices, estruturas);
+        ok = 0;
     }
+    if (entradaPadrao != NULL)
+        entradaPadrao->fp = NULL;
+    if (!ok)
+        return 0;
 
-    char linha[MAX_LINE];
-    long offset;
-    clock_t inicio, fim;
-    double tempo_vetor = 0.0, tempo_bst = 0.0, tempo_avl = 0.0;
+    printf("\nLeitura em fluxo (%s): %.1f MB em %ld buffers de %d KB, %.6f segundos (%.1f MB/s)\n",
+           entradaPadrao != NULL ? "entrada padrao" : stream_format_name(fonte.format),
+           leitura.bytes / 1e6, leitura.chunks, STREAM_CHUNK / 1024, leitura.total,
+           leitura.total > 0 ? leitura.bytes / 1e6 / leitura.total : 0.0);
+    printf("Espera do indexador por dados: %.6f s | espera da leitora por buffer livre: %.6f s\n",
+           leitura.indexer_wait, leitura.reader_wait);
+    printf("%u linhas retidas: %.1f KB\n", linhas->count, line_store_memory(linhas) / 1024.0);
 
-    initVector(vetor);
-    *bst = NULL;
-    *avl = NULL;
+    printf("\nTempo total de insercao:\n");
+    for (int t = 0; t < INDEX_NUM_TYPES; t++) {
+        if (estruturas & INDEX_MASK(t))
+            exibirTempo(indices, (IndexType)t, &stats);
+    }
+    return 1;
+}
 
-    while (1) {
-        offset = ftell(fp); // Posição da linha no arquivo
-        if (fgets(linha, MAX_LINE, fp) == NULL)
-            break;
-        linha[strcspn(linha, "\r\n")] = '\0';
-
-        char *citacao;
-        if (linha[0] == '\"') {
-            char *fimCitacao = strchr(linha + 1, '\"');
-            if (fimCitacao != NULL) {
-                *fimCitacao = '\0';
-                citacao = linha + 1;
-            } else {
-                citacao = linha + 1;
-            }
-        } else {
-            citacao = strtok(linha, ",");
+// Lê as palavras da pesquisa (separadas por espaço), já em minúsculo. Retorna quantas
+// foram lidas (0 em caso de erro de leitura).
+static int lerTermos(char termos[][100]) {
+    char entrada[256];
+    int n = 0;
+    while (n == 0) {
+        if (!fgets(entrada, sizeof(entrada), stdin)) {
+            fprintf(stderr, "Erro de leitura da palavra.\n");
+            return 0;
         }
-        if (citacao == NULL)
-            continue;
-
-        char citacaoProcessada[MAX_LINE];
-        strcpy(citacaoProcessada, citacao);
-        remove_punctuation(citacaoProcessada);
-        str_to_lower(citacaoProcessada);
-
-        char *token = strtok(citacaoProcessada, " ");
-        while (token != NULL) {
-            if (strlen(token) > 3) {
-                inicio = clock();
-                vector_insert(vetor, token, offset);
-                fim = clock();
-                tempo_vetor += ((double)(fim - inicio)) / CLOCKS_PER_SEC;
-                inicio = clock();
-                *bst = bst_insert(*bst, token, offset);
-                fim = clock();
-                tempo_bst += ((double)(fim - inicio)) / CLOCKS_PER_SEC;
-                inicio = clock();
-                *avl = avl_insert(*avl, token, offset);
-                fim = clock();
-                tempo_avl += ((double)(fim - inicio)) / CLOCKS_PER_SEC;
-            }
-            token = strtok(NULL, " ");
+        if (strchr(entrada, '\n') == NULL) {
+            int c;
+            while ((c = getchar()) != '\n' && c != EOF); // Limpa buffer
+        }
+        for (char *token = strtok(entrada, " \t\r\n"); token != NULL && n < MAX_TERMOS;
+             token = strtok(NULL, " \t\r\n")) {
+            strncpy(termos[n], token, 99);
+            termos[n][99] = '\0';
+            str_to_lower(termos[n]);
+            n++;
         }
     }
+    return n;
+}
 
-    fclose(fp);
-    printf("\nTempo total de insercao:\n");
-    printf("Vetor (pesquisa binaria): %.6f segundos\n", tempo_vetor);
-    printf("Arvore Binaria de Busca: %.6f segundos\n", tempo_bst);
-    printf("Arvore AVL: %.6f segundos\n", tempo_avl);
-    return 1;
+// Aloca espaço para a interseção de 'n' palavras (limitada pela mais rara)
+static uint32_t* alocarIntersecao(const IndexEntry *entradas, int n) {
+    int menor = entradas[0].count_docs;
+    for (int i = 1; i < n; i++) {
+        if (entradas[i].count_docs < menor)
+            menor = entradas[i].count_docs;
+    }
+    uint32_t *docs = (uint32_t *)malloc((menor + 1) * sizeof(uint32_t));
+    if (docs == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a interseção.\n");
+        exit(EXIT_FAILURE);
+    }
+    return docs;
 }
 
-void pesquisarPalavra(const char *nomeArquivo, Vector *vetor, BSTNode *bst, AVLNode *avl) {
-    char palavra[100];
-    printf("Digite a palavra a ser pesquisada: ");
-    scanf("%99s", palavra);
-    while(getchar() != '\n'); // Limpa buffer
-    str_to_lower(palavra);
+// Pesquisa uma ou mais palavras em cada estrutura. Com várias palavras, as citações
+// exibidas são as que contêm todas elas (interseção dos documentos de cada palavra).
+// Depois de uma carga em fluxo as citações vêm das linhas retidas, e não do arquivo.
+void pesquisarPalavra(const char *nomeArquivo, Index indices[], unsigned int estruturas,
+                      const DocTable *docs, const LineStore *linhas) {
+    char termos[MAX_TERMOS][100];
+    printf("Digite a palavra a ser pesquisada (ou varias, separadas por espaco): ");
+    int n = lerTermos(termos);
+    if (n == 0)
+        return;
 
     clock_t inicio, fim;
     double tempo;
+    IndexEntry encontradas[MAX_TERMOS];
+    bool achou = false;
 
-    inicio = clock();
-    WordEntry *entrada_vetor = vector_search_entry(vetor, palavra);
-    fim = clock();
-    tempo = ((double)(fim - inicio)) / CLOCKS_PER_SEC;
-    if (entrada_vetor != NULL)
-        printf("[Vetor] Palavra '%s' encontrada com frequencia %d (tempo: %.6f s).\n",
-               palavra, entrada_vetor->frequency, tempo);
-    else
-        printf("[Vetor] Palavra '%s' nao encontrada (tempo: %.6f s).\n",
-               palavra, tempo);
-
-    inicio = clock();
-    BSTNode *no_bst = bst_search(bst, palavra);
-    fim = clock();
-    tempo = ((double)(fim - inicio)) / CLOCKS_PER_SEC;
-    if (no_bst != NULL)
-        printf("[BST] Palavra '%s' encontrada com frequencia %d (tempo: %.6f s).\n",
-               palavra, no_bst->frequency, tempo);
-    else
-        printf("[BST] Palavra '%s' nao encontrada (tempo: %.6f s).\n",
-               palavra, tempo);
-
-    inicio = clock();
-    AVLNode *no_avl = avl_search(avl, palavra);
-    fim = clock();
-    tempo = ((double)(fim - inicio)) / CLOCKS_PER_SEC;
-    if (no_avl != NULL)
-        printf("[AVL] Palavra '%s' encontrada com frequencia %d (tempo: %.6f s).\n",
-               palavra, no_avl->frequency, tempo);
-    else
-        printf("[AVL] Palavra '%s' nao encontrada (tempo: %.6f s).\n",
-               palavra, tempo);
+    for (int t = 0; t < INDEX_NUM_TYPES; t++) {
+        if (!(estruturas & INDEX_MASK(t)))
+            continue;
+        IndexEntry entradas[MAX_TERMOS];
+        int achadas = 0;
+        int total = 0;
+        inicio = clock();
+        while (achadas < n && index_search(&indices[t], termos[achadas], &entradas[achadas]))
+            achadas++;
+        if (achadas == n && n > 1) {
+            uint32_t *intersecao = alocarIntersecao(entradas, n);
+            total = index_intersect(entradas, n, intersecao);
+            free(intersecao);
+        }
+        fim = clock();
+        tempo = ((double)(fim - inicio)) / CLOCKS_PER_SEC;
+        if (achadas < n) {
+            printf("[%s] Palavra '%s' nao encontrada (tempo: %.6f s).\n",
+                   index_short_name((IndexType)t), termos[achadas], tempo);
+            continue;
+        }
+        if (n == 1)
+            printf("[%s] Palavra '%s' encontrada com frequencia %d (tempo: %.6f s).\n",
+                   index_short_name((IndexType)t), termos[0], entradas[0].frequency, tempo);
+        else
+            printf("[%s] %d citacao(oes) com todas as %d palavras (tempo: %.6f s).\n",
+                   index_short_name((IndexType)t), total, n, tempo);
+        if (!achou) {
+            memcpy(encontradas, entradas, n * sizeof(IndexEntry));
+            achou = true;
+        }
+    }
 
-    if (entrada_vetor != NULL) {
-        FILE *fp = fopen(nomeArquivo, "r");
-        if (fp == NULL) {
-            fprintf(stderr, "Erro ao abrir o arquivo %s para leitura das citacoes.\n", nomeArquivo);
-            return;
+    if (achou) {
+        FILE *fp = NULL;
+        if (linhas->count == 0) {
+            fp = fopen(nomeArquivo, "r");
+            if (fp == NULL) {
+                fprintf(stderr, "Erro ao abrir o arquivo %s para leitura das citacoes.\n", nomeArquivo);
+                return;
+            }
         }
-        printf("\nCitacoes contendo a palavra '%s':\n", palavra);
+        if (n == 1)
+            printf("\nCitacoes contendo a palavra '%s':\n", termos[0]);
+        else
+            printf("\nCitacoes contendo todas as palavras:\n");
+        uint32_t *intersecao = alocarIntersecao(encontradas, n);
+        int total = index_intersect(encontradas, n, intersecao);
         char buffer[MAX_LINE];
-        for (int i = 0; i < entrada_vetor->count_offsets; i++) {
-            fseek(fp, entrada_vetor->offsets[i], SEEK_SET);
-            if (fgets(buffer, MAX_LINE, fp) != NULL) {
+        for (int i = 0; i < total; i++) {
+            if (fp == NULL) {
+                printf("-> %s\n", line_store_get(linhas, intersecao[i]));
+                continue;
+            }
+            fseek(fp, doc_table_offset(docs, intersecao[i]), SEEK_SET);
+            // Exibe a linha completa, preservando as aspas originais (linhas longas são
+            // lidas em pedaços)
+            printf("-> ");
+            int fimLinha = 0;
+            while (!fimLinha && read_line_chunk(fp, buffer, &fimLinha)) {
                 buffer[strcspn(buffer, "\r\n")] = '\0';
-                // Exibe a linha completa, preservando as aspas originais.
-                printf("-> %s\n", buffer);
+                fputs(buffer, stdout);
             }
+            printf("\n");
         }
-        fclose(fp);
+        free(intersecao);
+        if (fp != NULL)
+            fclose(fp);
     }
 }
 
-void buscaPorFrequencia(Vector *vetor) {
-    FreqNode *freqTree = NULL;
-    clock_t inicio, fim;
-    double tempo_insercao = 0.0;
+// Histograma de uma consulta por intervalo na tabela de frequências
+typedef struct {
+    int frequencia;              // Frequência da linha atual do histograma
+    int palavras;                // Palavras com essa frequência
+} Histograma;
+
+// Acumula as palavras de cada frequência e exibe uma linha quando a frequência muda
+static void contarNoHistograma(const char *palavra, int frequencia, void *ctx) {
+    Histograma *h = (Histograma *)ctx;
+    (void)palavra;
+    if (frequencia != h->frequencia) {
+        if (h->palavras > 0)
+            printf(" frequencia %d: %d palavra(s)\n", h->frequencia, h->palavras);
+        h->frequencia = frequencia;
+        h->palavras = 0;
+    }
+    h->palavras++;
+}
 
-    inicio = clock();
-    for (int i = 0; i < vetor->size; i++) {
-        freqTree = freq_avl_insert(freqTree, vetor->entries[i].frequency, &vetor->entries[i]);
+// Lê um inteiro não negativo de 'texto' até 'fim'. Retorna 1 se for válido, 0 se não
+// houver número e -1 se estiver fora do intervalo (a mensagem já foi exibida).
+static int lerFrequencia(const char *texto, char **fim, int *valor) {
+    long v = strtol(texto, fim, 10);
+    if (*fim == texto)
+        return 0;
+    if (v < 0 || v > INT_MAX) {
+        printf("Numero fora do intervalo!\n");
+        return -1;
     }
-    fim = clock();
-    tempo_insercao = ((double)(fim - inicio)) / CLOCKS_PER_SEC;
-    printf("\nArvore AVL de frequencia construída em %.6f segundos.\n", tempo_insercao);
+    *valor = (int)v;
+    return 1;
+}
 
-    printf("Digite a frequencia a ser pesquisada: ");
+// Pesquisa uma frequência na árvore e na tabela de frequência já construídas.
+// Um intervalo "min-max" é respondido pela tabela, como histograma.
+void buscaPorFrequencia(FreqIndex *arvore) {
+    clock_t inicio, fim;
+    printf("Digite a frequencia a ser pesquisada (ou um intervalo, ex: 5-10): ");
     char freqStr[64];
-    int freq;
+    int freq, freqMax;
     if (!fgets(freqStr, sizeof(freqStr), stdin)) {
         fprintf(stderr, "Erro de leitura da frequencia.\n");
-        freq_avl_free(freqTree);
         return;
     }
     freqStr[strcspn(freqStr, "\n")] = '\0';
     if (strlen(freqStr) == 0) {
         printf("Entrada invalida!\n");
-        freq_avl_free(freqTree);
         return;
     }
     char *endptr;
-    long freqVal = strtol(freqStr, &endptr, 10);
-    if (*endptr != '\0') {
+    int lida = lerFrequencia(freqStr, &endptr, &freq);
+    if (lida < 0)
+        return;
+    if (lida == 0) {
         printf("Entrada invalida! Por favor insira um numero inteiro.\n");
-        freq_avl_free(freqTree);
         return;
     }
-    if (freqVal < 0 || freqVal > INT_MAX) {
-        printf("Numero fora do intervalo!\n");
-        freq_avl_free(freqTree);
+    if (*endptr == '-') {
+        lida = lerFrequencia(endptr + 1, &endptr, &freqMax);
+        if (lida < 0)
+            return;
+        if (lida == 0 || *endptr != '\0') {
+            printf("Entrada invalida! Use o formato min-max.\n");
+            return;
+        }
+        Histograma h = {-1, 0};
+        inicio = clock();
+        int total = freq_table_range(&arvore->table, freq, freqMax, NULL, NULL);
+        fim = clock();
+        printf("[Tabela] %d palavra(s) com frequencia entre %d e %d (tempo: %.6f s):\n",
+               total, freq, freqMax, ((double)(fim - inicio)) / CLOCKS_PER_SEC);
+        freq_table_range(&arvore->table, freq, freqMax, contarNoHistograma, &h);
+        if (h.palavras > 0)
+            printf(" frequencia %d: %d palavra(s)\n", h.frequencia, h.palavras);
+        return;
+    }
+    if (*endptr != '\0') {
+        printf("Entrada invalida! Por favor insira um numero inteiro.\n");
         return;
     }
-    freq = (int)freqVal;
 
     inicio = clock();
-    FreqNode *noFreq = freq_avl_search(freqTree, freq);
+    FreqNode *noFreq = freq_avl_search(arvore->root, freq);
     fim = clock();
     double tempo_busca = ((double)(fim - inicio)) / CLOCKS_PER_SEC;
 
+    const char *const *palavras;
+    inicio = clock();
+    int naTabela = freq_table_lookup(&arvore->table, freq, &palavras);
+    fim = clock();
+    double tempo_tabela = ((double)(fim - inicio)) / CLOCKS_PER_SEC;
+
     if (noFreq != NULL) {
         printf("Foram encontradas %d palavra(s) com frequencia %d (tempo: %.6f s):\n",
                noFreq->count_words, freq, tempo_busca);
         for (int i = 0; i < noFreq->count_words; i++) {
-            printf(" - %s\n", noFreq->words[i]->word);
+            printf(" - %s\n", noFreq->words[i]);
         }
     } else {
         printf("Nenhuma palavra com frequencia %d foi encontrada (tempo: %.6f s).\n",
                freq, tempo_busca);
     }
+    printf("[Tabela] %d palavra(s) com frequencia %d (tempo: %.6f s).\n", naTabela, freq, tempo_tabela);
+}
+
+// Repete todas as consultas do log no índice e retorna o tempo total (em segundos)
+static double replayConsultas(Index *indice, const QueryLog *log, int *encontradas) {
+    IndexEntry entrada;
+    *encontradas = 0;
+    clock_t inicio = clock();
+    for (int i = 0; i < log->count; i++) {
+        if (index_search(indice, log->queries[i], &entrada))
+            (*encontradas)++;
+    }
+    clock_t fim = clock();
+    return ((double)(fim - inicio)) / CLOCKS_PER_SEC;
+}
+
+// Busca binária da palavra nas entradas em ordem alfabética
+static int buscaBinaria(WordEntry **ordem, int n, const char *palavra) {
+    int low = 0, high = n - 1;
+    while (low <= high) {
+        int mid = (low + high) / 2;
+        int cmp = strcmp(ordem[mid]->word, palavra);
+        if (cmp == 0)
+            return 1;
+        if (cmp < 0)
+            low = mid + 1;
+        else
+            high = mid - 1;
+    }
+    return 0;
+}
+
+// Repete as consultas no vetor apenas com a busca binária (sem a hash perfeita). O vetor
+// congelado está na ordem da hash, então a busca usa a ordem alfabética montada à parte
+// (fora da medição).
+static double replayBinaria(Vector *vetor, const QueryLog *log, int *encontradas) {
+    WordEntry **ordem = vector_sorted_entries(vetor);
+    *encontradas = 0;
+    clock_t inicio = clock();
+    for (int i = 0; i < log->count; i++)
+        *encontradas += buscaBinaria(ordem, vetor->size, log->queries[i]);
+    clock_t fim = clock();
+    free(ordem);
+    return ((double)(fim - inicio)) / CLOCKS_PER_SEC;
+}
+
+// Mede as consultas ausentes (palavras do log com um sufixo que não ocorre no corpus)
+// em cada estrutura, sem e com o filtro de Bloom, e exibe a taxa de falsos positivos.
+static void consultasAusentes(Index indices[], unsigned int construidas, const QueryLog *log,
+                              int bloomBits) {
+    QueryLog ausentes;
+    query_log_init(&ausentes);
+    char palavra[128];
+    for (int i = 0; i < log->count; i++) {
+        snprintf(palavra, sizeof(palavra), "%sqz", log->queries[i]);
+        query_log_add(&ausentes, palavra);
+    }
+    int bits = bloomBits > 0 ? bloomBits : BLOOM_DEFAULT_BITS_PER_KEY;
+
+    printf("\nConsultas ausentes (%d, filtro de Bloom com %d bits por palavra):\n", ausentes.count, bits);
+    for (int t = 0; t < INDEX_NUM_TYPES; t++) {
+        if (!(construidas & INDEX_MASK(t)))
+            continue;
+        int encontradas;
+        HotCache *cache = indices[t].cache;
+        indices[t].cache = NULL; // O cache só guarda acertos; fica fora desta medida
+        index_set_bloom(&indices[t], 0);
+        double semFiltro = replayConsultas(&indices[t], &ausentes, &encontradas);
+        index_set_bloom(&indices[t], bits);
+        double comFiltro = replayConsultas(&indices[t], &ausentes, &encontradas);
+        BloomFilter *bloom = indices[t].bloom;
+        long passaram = bloom->queries - bloom->rejected;
+        long ausentesDeFato = ausentes.count - encontradas;
+        double fpr = ausentesDeFato > 0 ? 100.0 * (passaram - encontradas) / ausentesDeFato : 0.0;
+        printf("[%s] sem filtro: %.6f s (%.1f ns/consulta) | com filtro: %.6f s (%.1f ns/consulta) | falsos positivos: %.2f%% (estimado %.2f%%)\n",
+               index_short_name((IndexType)t),
+               semFiltro, semFiltro * 1e9 / ausentes.count,
+               comFiltro, comFiltro * 1e9 / ausentes.count,
+               fpr, 100.0 * bloom_estimated_fpr(bloom));
+        // Restaura a configuração escolhida pelo usuário
+        index_set_bloom(&indices[t], bloomBits);
+        indices[t].cache = cache;
+    }
+    query_log_free(&ausentes);
+}
+
+// Resolve o log inteiro como um único lote no vetor e retorna o tempo (em segundos)
+static double loteConsultas(Vector *vetor, const QueryLog *log, int threads, int *encontradas) {
+    WordEntry **resultados = (WordEntry **)malloc(log->count * sizeof(WordEntry *));
+    if (resultados == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para os resultados do lote.\n");
+        exit(EXIT_FAILURE);
+    }
+    double inicio = load_wall_time();
+    vector_batch_search(vetor, log->queries, log->count, resultados, threads);
+    double fim = load_wall_time();
+    *encontradas = 0;
+    for (int i = 0; i < log->count; i++) {
+        if (resultados[i] != NULL)
+            (*encontradas)++;
+    }
+    free(resultados);
+    return fim - inicio;
+}
+
+// Memória das listas de documentos de uma estrutura
+typedef struct {
+    size_t bytes;                // Listas atuais (vetores de IDs e conjuntos compactados)
+    size_t offsets;              // Mesmas listas como um offset (long) por ocorrência
+    int compactadas;             // Palavras com conjunto compactado
+} MemoriaDocumentos;
+
+static void somarMemoria(const IndexEntry *entrada, void *ctx) {
+    MemoriaDocumentos *m = (MemoriaDocumentos *)ctx;
+    m->bytes += index_entry_doc_memory(entrada);
+    m->offsets += entrada->frequency * sizeof(long);
+    if (entrada->bitmap != NULL)
+        m->compactadas++;
+}
+
+// Palavras mais frequentes, em ordem decrescente de frequência
+typedef struct {
+    IndexEntry entradas[TOP_FREQUENTES];
+    int count;
+} Frequentes;
+
+static void guardarFrequente(const IndexEntry *entrada, void *ctx) {
+    Frequentes *f = (Frequentes *)ctx;
+    if (f->count == TOP_FREQUENTES && entrada->frequency <= f->entradas[f->count - 1].frequency)
+        return;
+    int i = (f->count < TOP_FREQUENTES) ? f->count++ : f->count - 1;
+    while (i > 0 && f->entradas[i - 1].frequency < entrada->frequency) {
+        f->entradas[i] = f->entradas[i - 1];
+        i--;
+    }
+    f->entradas[i] = *entrada;
+}
+
+static void copiarDocumento(uint32_t doc, void *ctx) {
+    uint32_t **pos = (uint32_t **)ctx;
+    *(*pos)++ = doc;
+}
+
+// Cruza todos os pares de palavras frequentes e retorna o tempo (em segundos)
+static double cruzarPares(const IndexEntry *entradas, int n, uint64_t *total) {
+    *total = 0;
+    double inicio = load_wall_time();
+    for (int r = 0; r < REPETICOES_INTERSECAO; r++) {
+        for (int i = 0; i < n; i++) {
+            for (int j = i + 1; j < n; j++)
+                *total += index_intersect_count(&entradas[i], &entradas[j]);
+        }
+    }
+    return load_wall_time() - inicio;
+}
+
+// Compara a memória das listas de documentos com a de um offset por ocorrência e mede
+// a interseção entre as palavras mais frequentes, com os conjuntos compactados e com
+// as mesmas listas expandidas em vetores de IDs.
+static void benchmarkDocumentos(Index indices[], unsigned int construidas) {
+    printf("\nListas de documentos:\n");
+    int origem = -1;
+    for (int t = 0; t < INDEX_NUM_TYPES; t++) {
+        if (!(construidas & INDEX_MASK(t)))
+            continue;
+        MemoriaDocumentos m = {0, 0, 0};
+        index_foreach(&indices[t], somarMemoria, &m);
+        printf("[%s] %.1f KB (%d palavra(s) compactada(s)) | um offset por ocorrencia: %.1f KB\n",
+               index_short_name((IndexType)t), m.bytes / 1024.0, m.compactadas, m.offsets / 1024.0);
+        if (origem < 0)
+            origem = t;
+    }
+    if (origem < 0)
+        return;
+
+    Frequentes f;
+    f.count = 0;
+    index_foreach(&indices[origem], guardarFrequente, &f);
+    if (f.count < 2)
+        return;
+    IndexEntry expandidas[TOP_FREQUENTES];
+    int compactadas = 0;
+    for (int i = 0; i < f.count; i++) {
+        uint32_t *docs = (uint32_t *)malloc((f.entradas[i].count_docs + 1) * sizeof(uint32_t));
+        if (docs == NULL) {
+            fprintf(stderr, "Erro ao alocar memória para os documentos.\n");
+            exit(EXIT_FAILURE);
+        }
+        uint32_t *pos = docs;
+        index_entry_foreach_doc(&f.entradas[i], copiarDocumento, &pos);
+        expandidas[i] = f.entradas[i];
+        expandidas[i].docs = docs;
+        expandidas[i].bitmap = NULL;
+        compactadas += (f.entradas[i].bitmap != NULL);
+    }
+    int pares = f.count * (f.count - 1) / 2 * REPETICOES_INTERSECAO;
+    uint64_t comuns, comunsVetor;
+    double compactado = cruzarPares(f.entradas, f.count, &comuns);
+    double vetor = cruzarPares(expandidas, f.count, &comunsVetor);
+    printf("[%s] intersecao das %d palavras mais frequentes (%d compactadas), %d pares:\n",
+           index_short_name((IndexType)origem), f.count, compactadas, pares);
+    printf(" conjuntos compactados: %.6f s (%.1f ns/par) | vetores de IDs: %.6f s (%.1f ns/par) | %llu documentos em comum\n",
+           compactado, compactado * 1e9 / pares, vetor, vetor * 1e9 / pares,
+           (unsigned long long)(comuns / REPETICOES_INTERSECAO));
+    if (comuns != comunsVetor)
+        fprintf(stderr, "Interseções divergentes: %llu e %llu.\n",
+                (unsigned long long)comuns, (unsigned long long)comunsVetor);
+    for (int i = 0; i < f.count; i++)
+        free((uint32_t *)expandidas[i].docs);
+}
+
+// Mede o tempo de busca de cada estrutura construída repetindo um log de consultas,
+// sem e com o cache de termos frequentes. Sem log, gera consultas com distribuição
+// de Zipf sobre o vocabulário (poucas palavras concentram a maioria das buscas).
+void benchmarkConsultas(Index indices[], unsigned int construidas, bool usarCache, int bloomBits) {
+    char caminho[256];
+    printf("Arquivo de log de consultas (uma palavra por linha; Enter para gerar %d consultas Zipf): ",
+           ZIPF_QUERIES);
+    if (!fgets(caminho, sizeof(caminho), stdin)) {
+        fprintf(stderr, "Erro de leitura do arquivo de log.\n");
+        return;
+    }
+    caminho[strcspn(caminho, "\r\n")] = '\0';
+
+    QueryLog log;
+    query_log_init(&log);
+    if (strlen(caminho) > 0) {
+        if (!query_log_load(&log, caminho)) {
+            query_log_free(&log);
+            return;
+        }
+    } else {
+        for (int t = 0; t < INDEX_NUM_TYPES; t++) {
+            if (construidas & INDEX_MASK(t)) {
+                query_log_generate_zipf(&log, &indices[t], ZIPF_QUERIES, ZIPF_EXPONENT, ZIPF_SEED);
+                break;
+            }
+        }
+    }
+    if (log.count == 0) {
+        printf("Nenhuma consulta para repetir.\n");
+        query_log_free(&log);
+        return;
+    }
+
+    printf("\nReplay de %d consultas:\n", log.count);
+    for (int t = 0; t < INDEX_NUM_TYPES; t++) {
+        if (!(construidas & INDEX_MASK(t)))
+            continue;
+        int encontradas;
+        index_set_cache(&indices[t], 0);
+        double semCache = replayConsultas(&indices[t], &log, &encontradas);
+        index_set_cache(&indices[t], HOT_CACHE_SLOTS);
+        double comCache = replayConsultas(&indices[t], &log, &encontradas);
+        HotCache *cache = indices[t].cache;
+        double acertos = 100.0 * cache->hits / (double)(cache->hits + cache->misses);
+        printf("[%s] sem cache: %.6f s (%.1f ns/consulta) | com cache: %.6f s (%.1f ns/consulta, %.1f%% de acertos) | %d encontradas\n",
+               index_short_name((IndexType)t),
+               semCache, semCache * 1e9 / log.count,
+               comCache, comCache * 1e9 / log.count,
+               acertos, encontradas);
+        // Restaura a configuração escolhida pelo usuário
+        index_set_cache(&indices[t], usarCache ? HOT_CACHE_SLOTS : 0);
+    }
+
+    // Busca em lote no vetor (pela hash perfeita, ou ordenação + merge sem ela), com uma
+    // e com várias threads
+    if (construidas & INDEX_MASK(INDEX_VECTOR)) {
+        Vector *vetor = &indices[INDEX_VECTOR].data.vector;
+        int encontradas;
+        int threads = batch_default_threads();
+        double binaria = replayBinaria(vetor, &log, &encontradas);
+        printf("[Vetor sem hash] busca binaria: %.6f s (%.1f ns/consulta) | %d encontradas\n",
+               binaria, binaria * 1e9 / log.count, encontradas);
+        double umaThread = loteConsultas(vetor, &log, 1, &encontradas);
+        printf("[Vetor em lote] 1 thread: %.6f s (%.1f ns/consulta) | %d encontradas\n",
+               umaThread, umaThread * 1e9 / log.count, encontradas);
+        if (threads > 1) {
+            double varias = loteConsultas(vetor, &log, threads, &encontradas);
+            printf("[Vetor em lote] ate %d threads: %.6f s (%.1f ns/consulta) | %d encontradas\n",
+                   threads, varias, varias * 1e9 / log.count, encontradas);
+        }
+    }
+
+    consultasAusentes(indices, construidas, &log, bloomBits);
+    benchmarkDocumentos(indices, construidas);
+    query_log_free(&log);
+}
+
+// Lê do usuário quais estruturas devem ser construídas. Entrada vazia seleciona todas
+// (modo de comparação); em produção basta uma estrutura, com uma fração da memória.
+unsigned int escolherEstruturas(void) {
+    char entrada[128];
+    while (1) {
+        printf("Estruturas a construir (vetor, bst, avl, splay, skiplist, separadas por virgula, ou 'todas') [todas]: ");
+        if (!fgets(entrada, sizeof(entrada), stdin))
+            return INDEX_MASK_ALL;
+        entrada[strcspn(entrada, "\r\n")] = '\0';
+        if (strspn(entrada, " \t") == strlen(entrada))
+            return INDEX_MASK_ALL;
+        unsigned int estruturas = index_parse_mask(entrada);
+        if (estruturas != 0)
+            return estruturas;
+        printf("Estrutura invalida! Tente novamente.\n");
+    }
+}
+
+// Pergunta se o cache de termos frequentes deve ficar na frente das buscas
+bool escolherCache(void) {
+    char entrada[16];
+    printf("Ativar cache de termos frequentes nas buscas? (s/N): ");
+    if (!fgets(entrada, sizeof(entrada), stdin))
+        return false;
+    return entrada[0] == 's' || entrada[0] == 'S';
+}
+
+// Lê do usuário se a carga deve ser rápida: só a estrutura principal é construída antes
+// do menu e as demais ficam para uma thread de segundo plano.
+bool escolherCargaRapida(void) {
+    char entrada[16];
+    printf("Carga rapida (consultas liberadas apos a primeira estrutura; demais em segundo plano)? (s/N): ");
+    if (!fgets(entrada, sizeof(entrada), stdin))
+        return false;
+    return entrada[0] == 's' || entrada[0] == 'S';
+}
+
+// Incorpora as estruturas publicadas pela thread de segundo plano desde a última
+// verificação e avisa o usuário. Retorna a nova máscara de estruturas prontas.
+unsigned int atualizarProntas(BackgroundLoad *segundoPlano, Index indices[], unsigned int construidas) {
+    unsigned int novas = background_load_ready(segundoPlano) & ~construidas;
+    for (int t = 0; t < INDEX_NUM_TYPES; t++) {
+        if (!(novas & INDEX_MASK(t)))
+            continue;
+        printf("\n[Segundo plano] %s pronta %.6f segundos apos o inicio da carga.\n",
+               index_name((IndexType)t), segundoPlano->prontaEm[t]);
+        exibirTempo(indices, (IndexType)t, &segundoPlano->stats);
+    }
+    return construidas | novas;
+}
+
+// Lê do usuário quantos bits por palavra o filtro de Bloom deve usar (0 desativa).
+int escolherBloom(void) {
+    char entrada[16];
+    int bits;
+    printf("Bits por palavra do filtro de Bloom para palavras ausentes (0 desativa) [%d]: ",
+           BLOOM_DEFAULT_BITS_PER_KEY);
+    if (!fgets(entrada, sizeof(entrada), stdin) || sscanf(entrada, "%d", &bits) != 1)
+        return BLOOM_DEFAULT_BITS_PER_KEY;
+    return bits > 0 ? bits : 0;
+}
 
-    freq_avl_free(freqTree);
+// Cria o filtro de Bloom das estruturas construídas e exibe memória e falsos positivos
+void construirFiltros(Index indices[], unsigned int construidas, int bloomBits) {
+    BloomFilter *bloom = NULL;
+    double inicio = load_wall_time();
+    for (int t = 0; t < INDEX_NUM_TYPES; t++) {
+        if (construidas & INDEX_MASK(t)) {
+            index_set_bloom(&indices[t], bloomBits);
+            bloom = indices[t].bloom;
+        }
+    }
+    double fim = load_wall_time();
+    if (bloom == NULL)
+        return;
+    printf("Filtro de Bloom (%d bits por palavra, k = %d): %.1f KB por estrutura, %.6f segundos, falsos positivos estimados: %.2f%%\n",
+           bloom->bits_per_key, bloom->k, bloom_memory(bloom) / 1024.0, fim - inicio,
+           100.0 * bloom_estimated_fpr(bloom));
 }
 
-int main() {
+int main(int argc, char *argv[]) {
     // Configura o locale para o padrão do sistema (geralmente UTF-8 no Linux)
     setlocale(LC_ALL, "");
 
-    Vector vetor = {0};
-    BSTNode *bst = NULL;
-    AVLNode *avl = NULL;
+    Index indices[INDEX_NUM_TYPES];
+    unsigned int construidas = 0; // Máscara dos índices prontos para consulta
     bool arquivoCarregado = false;
-
+    BackgroundLoad segundoPlano;  // Construção das demais estruturas na carga rápida
+    memset(&segundoPlano, 0, sizeof(segundoPlano));
+    FreqIndex frequencia;         // Árvore de frequência montada na primeira consulta
+    bool frequenciaLocal = false;
+    FreqIndex *arvoreFrequencia = NULL; // Árvore em uso (local ou do segundo plano)
+    DocTable docs;                // Offset de cada linha (os índices guardam só os IDs)
+    doc_table_init(&docs);
+    LineStore linhas;             // Linhas retidas na carga em fluxo (sem arquivo para reabrir)
+    line_store_init(&linhas);
+    StreamSource entradaPadrao;   // Citações recebidas pela entrada padrão ("-")
+    bool lerEntradaPadrao = false;
+
+    // O arquivo pode vir da linha de comando; "-" lê as citações da entrada padrão
     char nomeArquivo[256];
-    printf("Informe o nome do arquivo, ex: 'movie_quotes.csv': ");
-    scanf("%255s", nomeArquivo);
-    while(getchar() != '\n');
+    if (argc > 1) {
+        strncpy(nomeArquivo, argv[1], sizeof(nomeArquivo) - 1);
+        nomeArquivo[sizeof(nomeArquivo) - 1] = '\0';
+    } else {
+        printf("Informe o nome do arquivo, ex: 'movie_quotes.csv': ");
+        scanf("%255s", nomeArquivo);
+        while(getchar() != '\n');
+    }
+    if (strcmp(nomeArquivo, "-") == 0) {
+        stream_attach_stdin(&entradaPadrao);
+        lerEntradaPadrao = true;
+    }
+    // Entrada padrão e arquivos compactados só podem ser lidos em sequência
+    bool emFluxo = lerEntradaPadrao || stream_detect(nomeArquivo) != STREAM_PLAIN;
+
+    unsigned int estruturas = escolherEstruturas();
+    bool usarCache = escolherCache();
+    int bloomBits = escolherBloom();
+    bool cargaRapida = false;
+    if (emFluxo)
+        printf("Leitura em fluxo: todas as estruturas sao construidas na mesma passada.\n");
+    else
+        cargaRapida = escolherCargaRapida();
 
+    // Os dados da entrada padrão chegam uma única vez: a carga acontece antes do menu
+    bool cargaInicial = lerEntradaPadrao;
     int opcao;
     do {
-        printf("\nMenu:\n");
-        printf("1. Carregar arquivo e construir estruturas\n");
-        printf("2. Pesquisar palavra\n");
-        printf("3. Buscar por frequencia\n");
-        printf("4. Sair\n");
-        printf("Escolha uma opcao: ");
-
-        char opcaoStr[16];
-        if (!fgets(opcaoStr, sizeof(opcaoStr), stdin)) {
-            fprintf(stderr, "Erro de leitura de opcao.\n");
-            opcao = 4;
+        construidas = atualizarProntas(&segundoPlano, indices, construidas);
+        if (cargaInicial) {
+            opcao = 1;
+            cargaInicial = false;
         } else {
-            if (sscanf(opcaoStr, "%d", &opcao) != 1) {
-                opcao = -1;
+            printf("\nMenu:\n");
+            printf("1. Carregar arquivo e construir estruturas\n");
+            printf("2. Pesquisar palavra\n");
+            printf("3. Buscar por frequencia\n");
+            printf("4. Benchmark de consultas (replay de log)\n");
+            printf("5. Sair\n");
+            printf("Escolha uma opcao: ");
+
+            char opcaoStr[16];
+            if (!fgets(opcaoStr, sizeof(opcaoStr), stdin)) {
+                fprintf(stderr, "Erro de leitura de opcao.\n");
+                opcao = OPCAO_SAIR;
+            } else {
+                if (sscanf(opcaoStr, "%d", &opcao) != 1) {
+                    opcao = -1;
+                }
             }
         }
+        // Estruturas que ficaram prontas enquanto o usuário escolhia a opção
+        construidas = atualizarProntas(&segundoPlano, indices, construidas);
 
         switch(opcao) {
-            case 1:
-                if (vetor.size > 0) { freeVector(&vetor); }
-                if (bst != NULL) { bst_free(bst); bst = NULL; }
-                if (avl != NULL) { avl_free(avl); avl = NULL; }
-                if (carregarArquivo(nomeArquivo, &vetor, &bst, &avl)) {
+            case 1: {
+                if (lerEntradaPadrao && entradaPadrao.fp == NULL) {
+                    printf("A entrada padrao ja foi lida; as estruturas atuais foram mantidas.\n");
+                    break;
+                }
+                // A thread anterior precisa terminar antes de as estruturas serem liberadas
+                background_load_wait(&segundoPlano);
+                construidas |= background_load_ready(&segundoPlano);
+                if (frequenciaLocal)
+                    freq_index_free(&frequencia);
+                frequenciaLocal = false;
+                arvoreFrequencia = NULL;
+                background_load_free(&segundoPlano);
+                liberarEstruturas(indices, construidas);
+                construidas = 0;
+                doc_table_free(&docs);
+                line_store_free(&linhas);
+
+                double inicio = load_wall_time();
+                unsigned int primeiras = cargaRapida ? INDEX_MASK(load_primary(estruturas)) : estruturas;
+                int carregado = emFluxo
+                    ? carregarFluxo(nomeArquivo, lerEntradaPadrao ? &entradaPadrao : NULL,
+                                    indices, primeiras, &linhas)
+                    : carregarArquivo(nomeArquivo, indices, primeiras, &docs);
+                if (carregado) {
+                    construidas = primeiras;
                     arquivoCarregado = true;
+                    if (usarCache) {
+                        for (int t = 0; t < INDEX_NUM_TYPES; t++) {
+                            if (construidas & INDEX_MASK(t))
+                                index_set_cache(&indices[t], HOT_CACHE_SLOTS);
+                        }
+                    }
+                    construirFiltros(indices, construidas, bloomBits);
+                    printf("Consultas liberadas %.6f segundos apos o inicio da carga.\n",
+                           load_wall_time() - inicio);
+                    if (primeiras != estruturas) {
+                        printf("Demais estruturas e arvore de frequencia em construcao em segundo plano.\n");
+                        background_load_start(&segundoPlano, nomeArquivo, indices, &docs,
+                                              estruturas & ~primeiras,
+                                              usarCache ? HOT_CACHE_SLOTS : 0, bloomBits, true);
+                    }
                 } else {
                     arquivoCarregado = false;
                 }
                 break;
+            }
             case 2:
                 if (!arquivoCarregado) {
                     printf("Nenhum arquivo carregado. Use a opcao 1 primeiro.\n");
                     break;
                 }
-                pesquisarPalavra(nomeArquivo, &vetor, bst, avl);
+                pesquisarPalavra(nomeArquivo, indices, construidas, &docs, &linhas);
                 break;
             case 3:
                 if (!arquivoCarregado) {
                     printf("Nenhum arquivo carregado. Use a opcao 1 primeiro.\n");
                     break;
                 }
-                buscaPorFrequencia(&vetor);
+                if (arvoreFrequencia == NULL && background_load_frequency_ready(&segundoPlano)) {
+                    arvoreFrequencia = &segundoPlano.frequencia;
+                    printf("\nArvore AVL de frequencia construída em segundo plano (%.6f s; tabela: %.6f s).\n",
+                           arvoreFrequencia->tree_time, arvoreFrequencia->table_time);
+                }
+                if (arvoreFrequencia == NULL) {
+                    // Construída na primeira consulta e reaproveitada até a próxima carga.
+                    // Qualquer índice pronto serve de origem: todos contêm as mesmas palavras
+                    for (int t = 0; t < INDEX_NUM_TYPES; t++) {
+                        if (construidas & INDEX_MASK(t)) {
+                            freq_index_build(&frequencia, &indices[t]);
+                            printf("\nArvore AVL de frequencia construída em %.6f segundos.\n",
+                                   frequencia.tree_time);
+                            printf("Tabela de frequencias construída em %.6f segundos (%d buckets densos, %d palavra(s) excedente(s)).\n",
+                                   frequencia.table_time, frequencia.table.dense_limit,
+                                   frequencia.table.overflow_count);
+                            frequenciaLocal = true;
+                            arvoreFrequencia = &frequencia;
+                            break;
+                        }
+                    }
+                }
+                buscaPorFrequencia(arvoreFrequencia);
                 break;
             case 4:
+                if (!arquivoCarregado) {
+                    printf("Nenhum arquivo carregado. Use a opcao 1 primeiro.\n");
+                    break;
+                }
+                benchmarkConsultas(indices, construidas, usarCache, bloomBits);
+                break;
+            case OPCAO_SAIR:
                 printf("Encerrando o programa.\n");
                 break;
             default:
                 printf("Opcao invalida! Tente novamente.\n");
         }
-    } while(opcao != 4);
-
-    freeVector(&vetor);
-    bst_free(bst);
-    avl_free(avl);
+    } while(opcao != OPCAO_SAIR);
+
+    background_load_wait(&segundoPlano);
+    construidas |= background_load_ready(&segundoPlano);
+    if (frequenciaLocal)
+        freq_index_free(&frequencia);
+    background_load_free(&segundoPlano);
+    liberarEstruturas(indices, construidas);
+    doc_table_free(&docs);
+    line_store_free(&linhas);
+    if (lerEntradaPadrao && entradaPadrao.fp != NULL)
+        stream_close(&entradaPadrao);
     return 0;
 }
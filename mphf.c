@@ -0,0 +1,231 @@
+#include "mphf.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Bits por bloco da tabela de rank (8 palavras de 64 bits)
+#define RANK_BLOCK_BITS 512
+#define RANK_BLOCK_WORDS (RANK_BLOCK_BITS / 64)
+
+// Identificação do formato gravado por mphf_save
+#define MPHF_MAGIC 0x4648504Du  // "MPHF"
+#define MPHF_VERSION 1u
+
+// Finalizador do MurmurHash3: espalha os bits de x
+static uint64_t mix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// Hash base da chave (FNV-1a de 64 bits, espalhado); calculado uma vez por chave
+static uint64_t hashKey(const char *key) {
+    uint64_t h = 14695981039346656037ULL;
+    for (const unsigned char *p = (const unsigned char *)key; *p; p++) {
+        h ^= *p;
+        h *= 1099511628211ULL;
+    }
+    return mix64(h);
+}
+
+// Posição da chave (pelo hash base) dentro de um nível
+static uint64_t levelPosition(uint64_t h, int level, uint64_t size) {
+    return mix64(h + (uint64_t)(level + 1) * 0x9E3779B97F4A7C15ULL) % size;
+}
+
+static int testBit(const uint64_t *bits, uint64_t i) {
+    return (bits[i >> 6] >> (i & 63)) & 1;
+}
+
+static void setBit(uint64_t *bits, uint64_t i) {
+    bits[i >> 6] |= (uint64_t)1 << (i & 63);
+}
+
+static void* xcalloc(size_t count, size_t size) {
+    void *ptr = calloc(count, size);
+    if (ptr == NULL && count > 0) {
+        fprintf(stderr, "Erro ao alocar memória para a função hash perfeita.\n");
+        exit(EXIT_FAILURE);
+    }
+    return ptr;
+}
+
+// Ordena hashes de reserva em ordem crescente
+static int compareHash(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Calcula a quantidade de bits ligados antes de cada bloco
+static void buildRanks(Mphf *mphf) {
+    uint64_t words = mphf->total_bits / 64;
+    uint64_t blocks = (words + RANK_BLOCK_WORDS - 1) / RANK_BLOCK_WORDS;
+    mphf->ranks = (uint32_t *)xcalloc(blocks + 1, sizeof(uint32_t));
+    uint32_t total = 0;
+    for (uint64_t w = 0; w < words; w++) {
+        if (w % RANK_BLOCK_WORDS == 0)
+            mphf->ranks[w / RANK_BLOCK_WORDS] = total;
+        total += (uint32_t)__builtin_popcountll(mphf->bits[w]);
+    }
+}
+
+// Quantidade de bits ligados antes da posição i
+static uint32_t rankOf(const Mphf *mphf, uint64_t i) {
+    uint64_t word = i >> 6;
+    uint64_t block = word / RANK_BLOCK_WORDS;
+    uint32_t r = mphf->ranks[block];
+    for (uint64_t w = block * RANK_BLOCK_WORDS; w < word; w++)
+        r += (uint32_t)__builtin_popcountll(mphf->bits[w]);
+    uint64_t mask = ((uint64_t)1 << (i & 63)) - 1;
+    return r + (uint32_t)__builtin_popcountll(mphf->bits[word] & mask);
+}
+
+void mphf_build(Mphf *mphf, const char **keys, uint32_t n, double gamma) {
+    memset(mphf, 0, sizeof(Mphf));
+    mphf->n = n;
+    if (gamma < 1.0)
+        gamma = 1.0;
+
+    // Chaves ainda sem posição (representadas pelo hash base)
+    uint64_t *restantes = (uint64_t *)xcalloc(n, sizeof(uint64_t));
+    for (uint32_t i = 0; i < n; i++)
+        restantes[i] = hashKey(keys[i]);
+    uint32_t count = n;
+
+    while (count > 0 && mphf->levels < MPHF_MAX_LEVELS) {
+        int level = mphf->levels;
+        uint64_t size = (uint64_t)(gamma * count) + 63;
+        size -= size % 64;
+        if (size < 64)
+            size = 64;
+        uint64_t *ocupado = (uint64_t *)xcalloc(size / 64, sizeof(uint64_t));
+        uint64_t *colisao = (uint64_t *)xcalloc(size / 64, sizeof(uint64_t));
+        for (uint32_t i = 0; i < count; i++) {
+            uint64_t p = levelPosition(restantes[i], level, size);
+            if (testBit(ocupado, p))
+                setBit(colisao, p);
+            else
+                setBit(ocupado, p);
+        }
+        // Fica no nível quem não colidiu; os demais tentam o próximo nível
+        uint32_t proximo = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            uint64_t p = levelPosition(restantes[i], level, size);
+            if (testBit(colisao, p))
+                restantes[proximo++] = restantes[i];
+        }
+        for (uint64_t w = 0; w < size / 64; w++)
+            ocupado[w] &= ~colisao[w];
+
+        mphf->bits = realloc(mphf->bits, (mphf->total_bits + size) / 8);
+        if (mphf->bits == NULL) {
+            fprintf(stderr, "Erro ao realocar memória para a função hash perfeita.\n");
+            exit(EXIT_FAILURE);
+        }
+        memcpy(mphf->bits + mphf->total_bits / 64, ocupado, size / 8);
+        mphf->level_bits[level] = size;
+        mphf->level_start[level] = mphf->total_bits;
+        mphf->total_bits += size;
+        mphf->levels++;
+        free(ocupado);
+        free(colisao);
+        count = proximo;
+    }
+
+    // Reserva: chaves que colidiram em todos os níveis recebem os últimos valores
+    mphf->fallback_count = count;
+    if (count > 0) {
+        mphf->fallback_hashes = (uint64_t *)xcalloc(count, sizeof(uint64_t));
+        memcpy(mphf->fallback_hashes, restantes, count * sizeof(uint64_t));
+        qsort(mphf->fallback_hashes, count, sizeof(uint64_t), compareHash);
+    }
+    free(restantes);
+    buildRanks(mphf);
+}
+
+uint32_t mphf_lookup(const Mphf *mphf, const char *key) {
+    uint64_t h = hashKey(key);
+    for (int level = 0; level < mphf->levels; level++) {
+        uint64_t p = mphf->level_start[level] + levelPosition(h, level, mphf->level_bits[level]);
+        if (testBit(mphf->bits, p))
+            return rankOf(mphf, p);
+    }
+    // Busca binária na reserva
+    uint32_t low = 0, high = mphf->fallback_count;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (mphf->fallback_hashes[mid] < h)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    if (low < mphf->fallback_count && mphf->fallback_hashes[low] == h)
+        return mphf->n - mphf->fallback_count + low;
+    return MPHF_NOT_FOUND;
+}
+
+uint64_t mphf_memory_bits(const Mphf *mphf) {
+    uint64_t blocks = (mphf->total_bits / 64 + RANK_BLOCK_WORDS - 1) / RANK_BLOCK_WORDS + 1;
+    return mphf->total_bits + blocks * 32 + (uint64_t)mphf->fallback_count * 64;
+}
+
+int mphf_save(const Mphf *mphf, FILE *fp) {
+    uint32_t header[4] = {MPHF_MAGIC, MPHF_VERSION, mphf->n, (uint32_t)mphf->levels};
+    if (fwrite(header, sizeof(uint32_t), 4, fp) != 4)
+        return 0;
+    if (fwrite(mphf->level_bits, sizeof(uint64_t), mphf->levels, fp) != (size_t)mphf->levels)
+        return 0;
+    if (mphf->total_bits > 0 &&
+        fwrite(mphf->bits, sizeof(uint64_t), mphf->total_bits / 64, fp) != mphf->total_bits / 64)
+        return 0;
+    if (fwrite(&mphf->fallback_count, sizeof(uint32_t), 1, fp) != 1)
+        return 0;
+    if (mphf->fallback_count > 0 &&
+        fwrite(mphf->fallback_hashes, sizeof(uint64_t), mphf->fallback_count, fp) != mphf->fallback_count)
+        return 0;
+    return 1;
+}
+
+int mphf_load(Mphf *mphf, FILE *fp) {
+    memset(mphf, 0, sizeof(Mphf));
+    uint32_t header[4];
+    if (fread(header, sizeof(uint32_t), 4, fp) != 4 || header[0] != MPHF_MAGIC ||
+        header[1] != MPHF_VERSION || header[3] > MPHF_MAX_LEVELS)
+        return 0;
+    mphf->n = header[2];
+    mphf->levels = (int)header[3];
+    if (fread(mphf->level_bits, sizeof(uint64_t), mphf->levels, fp) != (size_t)mphf->levels)
+        return 0;
+    for (int level = 0; level < mphf->levels; level++) {
+        if (mphf->level_bits[level] % 64 != 0)
+            return 0;
+        mphf->level_start[level] = mphf->total_bits;
+        mphf->total_bits += mphf->level_bits[level];
+    }
+    mphf->bits = (uint64_t *)xcalloc(mphf->total_bits / 64, sizeof(uint64_t));
+    if ((mphf->total_bits > 0 &&
+         fread(mphf->bits, sizeof(uint64_t), mphf->total_bits / 64, fp) != mphf->total_bits / 64) ||
+        fread(&mphf->fallback_count, sizeof(uint32_t), 1, fp) != 1 ||
+        mphf->fallback_count > mphf->n) {
+        mphf_free(mphf);
+        return 0;
+    }
+    mphf->fallback_hashes = (uint64_t *)xcalloc(mphf->fallback_count, sizeof(uint64_t));
+    if (mphf->fallback_count > 0 &&
+        fread(mphf->fallback_hashes, sizeof(uint64_t), mphf->fallback_count, fp) != mphf->fallback_count) {
+        mphf_free(mphf);
+        return 0;
+    }
+    buildRanks(mphf);
+    return 1;
+}
+
+void mphf_free(Mphf *mphf) {
+    free(mphf->bits);
+    free(mphf->ranks);
+    free(mphf->fallback_hashes);
+    memset(mphf, 0, sizeof(Mphf));
+}
@@ -0,0 +1,52 @@
+#ifndef MPHF_H
+#define MPHF_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+// Número máximo de níveis; chaves que colidirem em todos vão para a lista de reserva
+#define MPHF_MAX_LEVELS 24
+
+// Valor devolvido por mphf_lookup para chaves que certamente não estão no conjunto
+#define MPHF_NOT_FOUND UINT32_MAX
+
+// Função hash perfeita mínima no estilo BBHash: mapeia as n chaves de um conjunto fixo
+// para valores distintos em [0, n). Cada nível é um vetor de bits; uma chave fica no
+// primeiro nível em que sua posição não colide com nenhuma outra, e seu valor é o
+// número de bits ligados antes dessa posição (rank). Com gamma = 2 usa cerca de
+// 3 a 4 bits por chave. Para chaves fora do conjunto o valor é arbitrário: o chamador
+// deve sempre conferir a chave encontrada.
+typedef struct Mphf {
+    uint32_t n;                          // Número de chaves
+    int levels;                          // Níveis utilizados
+    uint64_t level_bits[MPHF_MAX_LEVELS];  // Tamanho de cada nível em bits (múltiplo de 64)
+    uint64_t level_start[MPHF_MAX_LEVELS]; // Primeiro bit de cada nível em bits
+    uint64_t total_bits;                 // Soma dos tamanhos dos níveis
+    uint64_t *bits;                      // Vetores de bits de todos os níveis, concatenados
+    uint32_t *ranks;                     // Bits ligados antes de cada bloco de 512 bits
+    uint32_t fallback_count;             // Chaves que colidiram em todos os níveis
+    uint64_t *fallback_hashes;           // Hashes dessas chaves, ordenados
+} Mphf;
+
+// Constrói a função para as n chaves (todas distintas). gamma >= 1 controla o tamanho
+// dos níveis em relação às chaves restantes (maior = construção mais rápida, mais bits).
+void mphf_build(Mphf *mphf, const char **keys, uint32_t n, double gamma);
+
+// Retorna o valor da chave em [0, n) ou MPHF_NOT_FOUND.
+uint32_t mphf_lookup(const Mphf *mphf, const char *key);
+
+// Memória ocupada pela função, em bits.
+uint64_t mphf_memory_bits(const Mphf *mphf);
+
+// Grava a função em um arquivo binário aberto (para acompanhar um índice persistido).
+// Retorna 1 em caso de sucesso.
+int mphf_save(const Mphf *mphf, FILE *fp);
+
+// Lê uma função gravada por mphf_save. Retorna 1 em caso de sucesso, 0 se o arquivo
+// não tiver o formato esperado.
+int mphf_load(Mphf *mphf, FILE *fp);
+
+// Libera a memória da função.
+void mphf_free(Mphf *mphf);
+
+#endif // MPHF_H
@@ -0,0 +1,190 @@
+#define _GNU_SOURCE
+#include "parallel_load.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "tokenizer.h"
+
+#define MAX_LOAD_THREADS 64
+
+// Faixa do arquivo processada por uma thread: linhas que começam em [start, end). Uma
+// linha maior que MAX_LINE é lida em vários pedaços, todos da faixa em que ela começa
+// e todos com o mesmo ID de documento.
+typedef struct {
+    const char *nomeArquivo;
+    long start;
+    long end;
+    SkipList *list;
+    const DocTable *docs;
+    DocTable local;          // Offsets dos pedaços da faixa (numeração em paralelo)
+    uint32_t first_doc;      // ID do primeiro pedaço (DOC_NOT_FOUND = procurar em docs)
+    int writer;
+    int ok;
+} LoadTask;
+
+// Insere a palavra na skip list com o escritor da thread (usada por tokenize_line)
+static void insertToken(const char *token, uint32_t doc, void *ctx) {
+    LoadTask *task = (LoadTask *)ctx;
+    skiplist_insert(task->list, task->writer, token, doc);
+}
+
+// Lê o próximo pedaço da faixa com fgets. Um pedaço que começa antes de 'end' pertence
+// à faixa; depois de 'end' a leitura só continua até terminar a linha em andamento.
+// *meio indica que o último pedaço lido não terminou a linha.
+static int nextChunk(FILE *fp, char linha[MAX_LINE], long end, long *offset, int *meio) {
+    *offset = ftell(fp);
+    if (*offset >= end && !*meio)
+        return 0;
+    int fimLinha;
+    if (!read_line_chunk(fp, linha, &fimLinha))
+        return 0;
+    *meio = !fimLinha;
+    return 1;
+}
+
+// Abre o arquivo na primeira linha da faixa (NULL se não puder ser aberto)
+static FILE* openRange(const LoadTask *task, char linha[MAX_LINE]) {
+    FILE *fp = fopen(task->nomeArquivo, "r");
+    if (fp == NULL)
+        return NULL;
+    if (task->start == 0) {
+        // Pula o BOM UTF-8 se existir
+        unsigned char bom[3];
+        if (fread(bom, 1, 3, fp) != 3 || !(bom[0] == 0xEF && bom[1] == 0xBB && bom[2] == 0xBF))
+            fseek(fp, 0, SEEK_SET);
+    } else {
+        // Se a faixa começa no meio de uma linha, essa linha pertence à faixa anterior
+        fseek(fp, task->start - 1, SEEK_SET);
+        int c = fgetc(fp);
+        int fimLinha = (c == '\n' || c == EOF);
+        while (!fimLinha && read_line_chunk(fp, linha, &fimLinha))
+            ;
+    }
+    return fp;
+}
+
+// Registra os offsets das linhas da faixa de uma thread, sem separar as palavras
+static void* numberRange(void *arg) {
+    LoadTask *task = (LoadTask *)arg;
+    char linha[MAX_LINE];
+    FILE *fp = openRange(task, linha);
+    if (fp == NULL) {
+        task->ok = 0;
+        return NULL;
+    }
+    long offset;
+    int meio = 0;
+    for (int inicio = 1; nextChunk(fp, linha, task->end, &offset, &meio); inicio = !meio) {
+        if (inicio)
+            doc_table_add(&task->local, offset); // Só o primeiro pedaço de cada linha
+    }
+    fclose(fp);
+    task->ok = 1;
+    return NULL;
+}
+
+// Processa as linhas da faixa de uma thread
+static void* loadRange(void *arg) {
+    LoadTask *task = (LoadTask *)arg;
+    char linha[MAX_LINE];
+    FILE *fp = openRange(task, linha);
+    if (fp == NULL) {
+        task->ok = 0;
+        return NULL;
+    }
+
+    // As linhas são lidas nos mesmos pontos da leitura sequencial, então basta saber
+    // o ID da primeira e contar a partir dele (um ID por linha, não por pedaço)
+    long offset; // Posição do pedaço no arquivo
+    int meio = 0;
+    uint32_t doc = task->first_doc;
+    while (nextChunk(fp, linha, task->end, &offset, &meio)) {
+        if (doc == DOC_NOT_FOUND) {
+            doc = doc_table_find(task->docs, offset);
+            if (doc == DOC_NOT_FOUND) {
+                fclose(fp);
+                task->ok = 0;
+                return NULL;
+            }
+        }
+        linha[strcspn(linha, "\r\n")] = '\0';
+        tokenize_line(linha, doc, insertToken, task);
+        if (!meio)
+            doc++;
+    }
+    fclose(fp);
+    task->ok = 1;
+    return NULL;
+}
+
+// Executa fn para cada faixa, uma thread por faixa. Retorna 1 se todas tiveram sucesso.
+static int runTasks(LoadTask tasks[], int threads, void* (*fn)(void *)) {
+    pthread_t ids[MAX_LOAD_THREADS];
+    int criada[MAX_LOAD_THREADS] = {0};
+    // A thread chamadora processa a primeira faixa
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&ids[t], NULL, fn, &tasks[t]) == 0)
+            criada[t] = 1;
+        else
+            fn(&tasks[t]); // Sem thread disponível: processa a faixa aqui mesmo
+    }
+    fn(&tasks[0]);
+    int ok = tasks[0].ok;
+    for (int t = 1; t < threads; t++) {
+        if (criada[t])
+            pthread_join(ids[t], NULL);
+        ok = ok && tasks[t].ok;
+    }
+    return ok;
+}
+
+int parallel_load_skiplist(const char *nomeArquivo, SkipList *list, int threads,
+                           DocTable *docs) {
+    FILE *fp = fopen(nomeArquivo, "r");
+    if (fp == NULL) {
+        fprintf(stderr, "Erro ao abrir o arquivo %s.\n", nomeArquivo);
+        return 0;
+    }
+    fseek(fp, 0, SEEK_END);
+    long tamanho = ftell(fp);
+    fclose(fp);
+
+    if (threads > list->writer_count)
+        threads = list->writer_count;
+    if (threads > MAX_LOAD_THREADS)
+        threads = MAX_LOAD_THREADS;
+    if (threads < 1)
+        threads = 1;
+
+    LoadTask tasks[MAX_LOAD_THREADS];
+    for (int t = 0; t < threads; t++) {
+        tasks[t].nomeArquivo = nomeArquivo;
+        tasks[t].start = (long)((long long)tamanho * t / threads);
+        tasks[t].end = (t == threads - 1) ? tamanho + 1 : (long)((long long)tamanho * (t + 1) / threads);
+        tasks[t].list = list;
+        tasks[t].docs = docs;
+        doc_table_init(&tasks[t].local);
+        tasks[t].first_doc = DOC_NOT_FOUND;
+        tasks[t].writer = t;
+        tasks[t].ok = 0;
+    }
+
+    int ok = 1;
+    if (docs->count == 0) {
+        // Tabela vazia: cada thread conta os pedaços da sua faixa e a soma de prefixos
+        // das contagens dá o ID do primeiro pedaço de cada faixa
+        ok = runTasks(tasks, threads, numberRange);
+        for (int t = 0; t < threads; t++) {
+            if (ok)
+                tasks[t].first_doc = doc_table_append(docs, &tasks[t].local);
+            doc_table_free(&tasks[t].local);
+        }
+    }
+    if (ok)
+        ok = runTasks(tasks, threads, loadRange);
+    if (!ok)
+        fprintf(stderr, "Erro ao ler o arquivo %s em paralelo.\n", nomeArquivo);
+    return ok;
+}
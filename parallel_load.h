@@ -0,0 +1,19 @@
+#ifndef PARALLEL_LOAD_H
+#define PARALLEL_LOAD_H
+
+#include "skiplist.h"
+#include "doc_table.h"
+
+// Carrega o arquivo de citações na skip list usando até 'threads' threads. O arquivo
+// é dividido em faixas de bytes alinhadas ao início das linhas; cada thread lê sua
+// faixa, separa as palavras e as insere diretamente na skip list (sem fase de merge).
+// Os IDs de documento vêm da tabela 'docs': se ela já estiver preenchida, cada thread
+// localiza o ID da primeira linha da sua faixa e conta a partir dele. Se estiver vazia,
+// uma primeira passada em paralelo conta os pedaços (fgets) de cada faixa e preenche a
+// tabela, e a soma de prefixos das contagens dá o ID inicial de cada faixa. Retorna 1
+// em caso de sucesso, 0 se o arquivo não puder ser aberto. A skip list deve ter pelo
+// menos 'threads' escritores.
+int parallel_load_skiplist(const char *nomeArquivo, SkipList *list, int threads,
+                           DocTable *docs);
+
+#endif // PARALLEL_LOAD_H
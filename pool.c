@@ -0,0 +1,113 @@
+#include "pool.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Alinhamento das alocações (suficiente para ponteiros e long)
+#define POOL_ALIGN 8
+
+// Arredonda n para o próximo múltiplo de POOL_ALIGN
+static size_t alignUp(size_t n) {
+    return (n + POOL_ALIGN - 1) & ~(size_t)(POOL_ALIGN - 1);
+}
+
+// Aloca um novo slab com pelo menos min_size bytes e o coloca no início da lista
+static Slab* newSlab(Pool *pool, size_t min_size) {
+    size_t capacity = (min_size > pool->slab_size) ? min_size : pool->slab_size;
+    Slab *slab = (Slab *)malloc(sizeof(Slab) + capacity);
+    if (slab == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para slab do pool.\n");
+        exit(EXIT_FAILURE);
+    }
+    slab->used = 0;
+    slab->capacity = capacity;
+    slab->next = pool->head;
+    pool->head = slab;
+    pool->slab_count++;
+    return slab;
+}
+
+void pool_init(Pool *pool, size_t slab_size) {
+    pool->head = NULL;
+    pool->slab_size = alignUp(slab_size);
+    pool->slab_count = 0;
+}
+
+void* pool_alloc(Pool *pool, size_t size) {
+    size = alignUp(size);
+    Slab *slab = pool->head;
+    if (slab == NULL || slab->capacity - slab->used < size) {
+        if (size > pool->slab_size / 4 && slab != NULL) {
+            // Blocos grandes ganham um slab próprio, inserido após o atual,
+            // para não desperdiçar o espaço restante do slab corrente
+            Slab *big = (Slab *)malloc(sizeof(Slab) + size);
+            if (big == NULL) {
+                fprintf(stderr, "Erro ao alocar memória para slab do pool.\n");
+                exit(EXIT_FAILURE);
+            }
+            big->used = size;
+            big->capacity = size;
+            big->next = slab->next;
+            slab->next = big;
+            pool->slab_count++;
+            return big->data;
+        }
+        slab = newSlab(pool, size);
+    }
+    void *ptr = slab->data + slab->used;
+    slab->used += size;
+    return ptr;
+}
+
+char* pool_strdup(Pool *pool, const char *str) {
+    size_t len = strlen(str) + 1;
+    char *copy = (char *)pool_alloc(pool, len);
+    memcpy(copy, str, len);
+    return copy;
+}
+
+void* pool_realloc(Pool *pool, void *ptr, size_t old_size, size_t new_size) {
+    if (ptr == NULL)
+        return pool_alloc(pool, new_size);
+    old_size = alignUp(old_size);
+    new_size = alignUp(new_size);
+    Slab *slab = pool->head;
+    // Cresce no lugar se o bloco for a última alocação do slab atual
+    if (slab != NULL && (unsigned char *)ptr + old_size == slab->data + slab->used &&
+        slab->capacity - slab->used >= new_size - old_size) {
+        slab->used += new_size - old_size;
+        return ptr;
+    }
+    void *novo = pool_alloc(pool, new_size);
+    memcpy(novo, ptr, old_size < new_size ? old_size : new_size);
+    return novo;
+}
+
+void pool_destroy(Pool *pool) {
+    Slab *slab = pool->head;
+    while (slab != NULL) {
+        Slab *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    pool->head = NULL;
+    pool->slab_count = 0;
+}
+
+size_t pool_memory(const Pool *pool) {
+    size_t total = 0;
+    for (const Slab *slab = pool->head; slab != NULL; slab = slab->next)
+        total += sizeof(Slab) + slab->capacity;
+    return total;
+}
+
+void tree_pool_init(TreePool *tp) {
+    pool_init(&tp->nodes, POOL_SLAB_SIZE);
+    pool_init(&tp->postings, POOL_SLAB_SIZE);
+}
+
+void tree_pool_destroy(TreePool *tp) {
+    pool_destroy(&tp->nodes);
+    pool_destroy(&tp->postings);
+}
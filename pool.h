@@ -0,0 +1,58 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+
+// Tamanho padrão de cada slab (bloco grande de memória de onde os nós são retirados)
+#define POOL_SLAB_SIZE (64 * 1024)
+
+// Slab: bloco contíguo alocado com malloc. As alocações são feitas em sequência
+// (bump pointer) dentro de data, e os slabs formam uma lista encadeada.
+typedef struct Slab {
+    struct Slab *next;   // Slab alocado anteriormente
+    size_t used;         // Bytes já utilizados em data
+    size_t capacity;     // Capacidade de data em bytes
+    unsigned char data[];
+} Slab;
+
+// Pool de memória: não existe liberação individual; toda a memória é devolvida
+// de uma vez em pool_destroy, liberando apenas os slabs.
+typedef struct {
+    Slab *head;          // Slab atual (onde ocorrem as próximas alocações)
+    size_t slab_size;    // Capacidade dos novos slabs
+    size_t slab_count;   // Quantidade de slabs alocados
+} Pool;
+
+// Conjunto de pools de uma árvore: os nós, com o prefixo das palavras (acessados em toda
+// busca), ficam contíguos em nodes. Em postings ficam os dados frios: as listas de
+// documentos e as palavras mais longas que o prefixo.
+typedef struct {
+    Pool nodes;
+    Pool postings;
+} TreePool;
+
+// Inicializa um pool vazio. Nenhuma memória é alocada até a primeira alocação.
+void pool_init(Pool *pool, size_t slab_size);
+
+// Aloca size bytes alinhados do pool. Encerra o programa se faltar memória.
+void* pool_alloc(Pool *pool, size_t size);
+
+// Copia a string para dentro do pool.
+char* pool_strdup(Pool *pool, const char *str);
+
+// Redimensiona um bloco obtido do pool. Se ele for o último bloco do slab atual e houver
+// espaço, cresce no próprio lugar; caso contrário, copia para um novo bloco (o antigo só é
+// devolvido em pool_destroy).
+void* pool_realloc(Pool *pool, void *ptr, size_t old_size, size_t new_size);
+
+// Libera todos os slabs do pool de uma vez e o deixa vazio para reutilização.
+void pool_destroy(Pool *pool);
+
+// Total de bytes reservados pelos slabs do pool.
+size_t pool_memory(const Pool *pool);
+
+// Inicializa/libera os dois pools de uma árvore.
+void tree_pool_init(TreePool *tp);
+void tree_pool_destroy(TreePool *tp);
+
+#endif // POOL_H
@@ -0,0 +1,57 @@
+#include "postings.h"
+
+#include <string.h>
+
+// Capacidade do vetor de documentos ao sair da forma inline
+#define INITIAL_DOC_CAPACITY 8
+
+Postings* postings_create(Pool *pool, const char *word, uint32_t doc) {
+    Postings *p = (Postings *)pool_alloc(pool, sizeof(Postings));
+    p->word = word;
+    p->frequency = 1;
+    p->count = 1;
+    p->data.inline_docs[0] = doc;
+    return p;
+}
+
+void postings_add(Postings *p, uint32_t doc, Pool *pool) {
+    p->frequency++;
+    if (p->count >= POSTINGS_BITMAP_MIN) {
+        if (p->data.bitmap->last != doc) {
+            roaring_add(p->data.bitmap, doc, pool);
+            p->count = (int32_t)p->data.bitmap->cardinality;
+        }
+        return;
+    }
+    const uint32_t *docs = postings_docs(p);
+    if (docs[p->count - 1] == doc)
+        return; // Outra ocorrência na mesma linha
+    if (p->count < POSTINGS_INLINE) {
+        p->data.inline_docs[p->count++] = doc;
+        return;
+    }
+    if (p->count == POSTINGS_BITMAP_MIN - 1) {
+        // Palavra comum: troca o vetor pelo conjunto compactado. O vetor fica no pool
+        // até a árvore ser liberada, mas seu tamanho é limitado a POSTINGS_BITMAP_MIN IDs
+        Roaring *bitmap = roaring_create(pool);
+        for (int i = 0; i < p->count; i++)
+            roaring_add(bitmap, p->data.heap.items[i], pool);
+        roaring_add(bitmap, doc, pool);
+        p->data.bitmap = bitmap;
+        p->count++;
+        return;
+    }
+    if (p->count == POSTINGS_INLINE) {
+        // Sai da forma inline: move os documentos para um vetor no pool
+        uint32_t *items = (uint32_t *)pool_alloc(pool, INITIAL_DOC_CAPACITY * sizeof(uint32_t));
+        memcpy(items, p->data.inline_docs, POSTINGS_INLINE * sizeof(uint32_t));
+        p->data.heap.items = items;
+        p->data.heap.capacity = INITIAL_DOC_CAPACITY;
+    } else if (p->count >= p->data.heap.capacity) {
+        p->data.heap.items = pool_realloc(pool, p->data.heap.items,
+                                          p->data.heap.capacity * sizeof(uint32_t),
+                                          p->data.heap.capacity * 2 * sizeof(uint32_t));
+        p->data.heap.capacity *= 2;
+    }
+    p->data.heap.items[p->count++] = doc;
+}
@@ -0,0 +1,53 @@
+#ifndef POSTINGS_H
+#define POSTINGS_H
+
+#include <stdint.h>
+#include "pool.h"
+#include "roaring.h"
+
+// Quantidade de documentos guardados dentro da própria estrutura (sem vetor separado)
+#define POSTINGS_INLINE 4
+
+// A partir deste número de documentos a palavra é comum o bastante para que os IDs
+// passem a ser guardados em um conjunto compactado (Roaring) em vez de um vetor.
+#define POSTINGS_BITMAP_MIN 128
+
+// Dados "frios" de uma palavra indexada: só são lidos quando a busca termina.
+// Os nós das árvores guardam apenas o prefixo da chave e um ponteiro para esta estrutura.
+// Os documentos (IDs de linha) são distintos e chegam em ordem crescente na carga.
+typedef struct {
+    const char *word;        // Palavra completa
+    int32_t frequency;       // Frequência da palavra (ocorrências)
+    int32_t count;           // Quantidade de documentos distintos
+    union {
+        uint32_t inline_docs[POSTINGS_INLINE]; // Usado enquanto count <= POSTINGS_INLINE
+        struct {
+            uint32_t *items; // Vetor de IDs (no pool) enquanto count < POSTINGS_BITMAP_MIN
+            int32_t capacity;
+        } heap;
+        Roaring *bitmap;     // Conjunto compactado quando count >= POSTINGS_BITMAP_MIN
+    } data;
+} Postings;
+
+// Cria os postings de uma palavra com sua primeira ocorrência. A string word não é
+// copiada: o chamador garante que ela vive tanto quanto o pool.
+Postings* postings_create(Pool *pool, const char *word, uint32_t doc);
+
+// Registra mais uma ocorrência da palavra (frequência e documento). Uma nova ocorrência
+// no mesmo documento da anterior só incrementa a frequência.
+void postings_add(Postings *p, uint32_t doc, Pool *pool);
+
+// Retorna o vetor contíguo de documentos (p->count elementos) ou NULL se os documentos
+// estiverem no conjunto compactado.
+static inline const uint32_t* postings_docs(const Postings *p) {
+    if (p->count >= POSTINGS_BITMAP_MIN)
+        return NULL;
+    return (p->count <= POSTINGS_INLINE) ? p->data.inline_docs : p->data.heap.items;
+}
+
+// Retorna o conjunto compactado de documentos ou NULL se a palavra usar um vetor.
+static inline const Roaring* postings_bitmap(const Postings *p) {
+    return (p->count >= POSTINGS_BITMAP_MIN) ? p->data.bitmap : NULL;
+}
+
+#endif // POSTINGS_H
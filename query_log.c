@@ -0,0 +1,144 @@
+#include "query_log.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+
+#define INITIAL_LOG_CAPACITY 1024
+#define MAX_QUERY 256
+
+// Palavra do vocabulário com sua frequência (usada para ordenar por posto)
+typedef struct {
+    const char *word;
+    int frequency;
+} RankedWord;
+
+// Vocabulário coletado via index_foreach
+typedef struct {
+    RankedWord *items;
+    int count;
+    int capacity;
+} Vocabulary;
+
+void query_log_init(QueryLog *log) {
+    log->count = 0;
+    log->capacity = INITIAL_LOG_CAPACITY;
+    log->queries = (const char **)malloc(log->capacity * sizeof(const char *));
+    if (log->queries == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o log de consultas.\n");
+        exit(EXIT_FAILURE);
+    }
+    pool_init(&log->strings, POOL_SLAB_SIZE);
+}
+
+void query_log_add(QueryLog *log, const char *word) {
+    if (log->count >= log->capacity) {
+        log->capacity *= 2;
+        log->queries = realloc(log->queries, log->capacity * sizeof(const char *));
+        if (log->queries == NULL) {
+            fprintf(stderr, "Erro ao realocar memória para o log de consultas.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    log->queries[log->count++] = pool_strdup(&log->strings, word);
+}
+
+int query_log_load(QueryLog *log, const char *path) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        fprintf(stderr, "Erro ao abrir o log de consultas %s.\n", path);
+        return 0;
+    }
+    char linha[MAX_QUERY];
+    while (fgets(linha, sizeof(linha), fp) != NULL) {
+        linha[strcspn(linha, "\r\n")] = '\0';
+        char *palavra = strtok(linha, " \t");
+        if (palavra == NULL)
+            continue;
+        for (int i = 0; palavra[i]; i++) {
+            if ((unsigned char)palavra[i] < 128)
+                palavra[i] = tolower((unsigned char)palavra[i]);
+        }
+        query_log_add(log, palavra);
+    }
+    fclose(fp);
+    return 1;
+}
+
+// Acrescenta cada palavra do índice ao vocabulário (usada com index_foreach)
+static void collectWord(const IndexEntry *entry, void *ctx) {
+    Vocabulary *vocab = (Vocabulary *)ctx;
+    if (vocab->count >= vocab->capacity) {
+        vocab->capacity = (vocab->capacity == 0) ? INITIAL_LOG_CAPACITY : vocab->capacity * 2;
+        vocab->items = realloc(vocab->items, vocab->capacity * sizeof(RankedWord));
+        if (vocab->items == NULL) {
+            fprintf(stderr, "Erro ao alocar memória para o vocabulário.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    vocab->items[vocab->count].word = entry->word;
+    vocab->items[vocab->count].frequency = entry->frequency;
+    vocab->count++;
+}
+
+// Ordena por frequência decrescente (empates em ordem alfabética)
+static int compareRank(const void *a, const void *b) {
+    const RankedWord *x = (const RankedWord *)a;
+    const RankedWord *y = (const RankedWord *)b;
+    if (x->frequency != y->frequency)
+        return (x->frequency > y->frequency) ? -1 : 1;
+    return strcmp(x->word, y->word);
+}
+
+// Número pseudoaleatório uniforme em [0, 1), combinando duas chamadas de rand()
+// para ter resolução suficiente mesmo quando RAND_MAX é pequeno
+static double uniform(void) {
+    double r = (double)rand() / ((double)RAND_MAX + 1.0);
+    return (r + (double)rand()) / ((double)RAND_MAX + 1.0);
+}
+
+void query_log_generate_zipf(QueryLog *log, Index *source, int n, double s, unsigned int seed) {
+    Vocabulary vocab = {NULL, 0, 0};
+    index_foreach(source, collectWord, &vocab);
+    if (vocab.count == 0)
+        return;
+    qsort(vocab.items, vocab.count, sizeof(RankedWord), compareRank);
+
+    // Distribuição acumulada dos pesos 1/k^s
+    double *cdf = (double *)malloc(vocab.count * sizeof(double));
+    if (cdf == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a distribuição de Zipf.\n");
+        exit(EXIT_FAILURE);
+    }
+    double total = 0.0;
+    for (int k = 0; k < vocab.count; k++) {
+        total += 1.0 / pow(k + 1, s);
+        cdf[k] = total;
+    }
+
+    srand(seed);
+    for (int i = 0; i < n; i++) {
+        double alvo = uniform() * total;
+        int low = 0, high = vocab.count - 1;
+        while (low < high) {
+            int mid = (low + high) / 2;
+            if (cdf[mid] < alvo)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        query_log_add(log, vocab.items[low].word);
+    }
+    free(cdf);
+    free(vocab.items);
+}
+
+void query_log_free(QueryLog *log) {
+    free(log->queries);
+    log->queries = NULL;
+    log->count = 0;
+    log->capacity = 0;
+    pool_destroy(&log->strings);
+}
@@ -0,0 +1,35 @@
+#ifndef QUERY_LOG_H
+#define QUERY_LOG_H
+
+#include "index.h"
+#include "pool.h"
+
+// Sequência de consultas usada para medir o desempenho das estruturas
+// (lida de um log real ou gerada com distribuição de Zipf).
+typedef struct {
+    const char **queries;    // Palavras consultadas, na ordem de replay
+    int count;               // Número de consultas
+    int capacity;            // Capacidade atual do vetor de consultas
+    Pool strings;            // Memória das palavras
+} QueryLog;
+
+// Inicializa um log vazio.
+void query_log_init(QueryLog *log);
+
+// Acrescenta uma consulta ao log (a palavra é copiada).
+void query_log_add(QueryLog *log, const char *word);
+
+// Lê um log de consultas com uma palavra por linha (linhas vazias são ignoradas).
+// As palavras são convertidas para minúsculo. Retorna 1 em caso de sucesso, 0 se
+// o arquivo não puder ser aberto.
+int query_log_load(QueryLog *log, const char *path);
+
+// Gera n consultas sobre as palavras do índice seguindo uma distribuição de Zipf
+// com expoente s: a palavra de posto k (por frequência no corpus) é consultada com
+// probabilidade proporcional a 1/k^s. A semente torna o resultado reproduzível.
+void query_log_generate_zipf(QueryLog *log, Index *source, int n, double s, unsigned int seed);
+
+// Libera a memória do log.
+void query_log_free(QueryLog *log);
+
+#endif // QUERY_LOG_H
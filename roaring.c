@@ -0,0 +1,204 @@
+#include "roaring.h"
+
+#include <string.h>
+
+// Capacidade inicial do vetor de contêineres e do vetor de um contêiner
+#define INITIAL_CONTAINERS 4
+#define INITIAL_ARRAY_CAPACITY 16
+
+Roaring* roaring_create(Pool *pool) {
+    Roaring *r = (Roaring *)pool_alloc(pool, sizeof(Roaring));
+    r->containers = (RoaringContainer *)pool_alloc(pool, INITIAL_CONTAINERS * sizeof(RoaringContainer));
+    r->count = 0;
+    r->capacity = INITIAL_CONTAINERS;
+    r->cardinality = 0;
+    r->last = 0;
+    return r;
+}
+
+// Posição do contêiner com a chave ou, se não existir, -(posição de inserção) - 1
+static int findContainer(const Roaring *r, uint16_t key) {
+    // Caso comum: valores crescentes sempre caem no último contêiner
+    if (r->count > 0 && r->containers[r->count - 1].key == key)
+        return r->count - 1;
+    int low = 0, high = r->count - 1;
+    while (low <= high) {
+        int mid = (low + high) / 2;
+        if (r->containers[mid].key < key)
+            low = mid + 1;
+        else if (r->containers[mid].key > key)
+            high = mid - 1;
+        else
+            return mid;
+    }
+    return -low - 1;
+}
+
+// Insere um contêiner de vetor vazio na posição pos
+static RoaringContainer* insertContainer(Roaring *r, int pos, uint16_t key, Pool *pool) {
+    if (r->count >= r->capacity) {
+        r->containers = pool_realloc(pool, r->containers, r->capacity * sizeof(RoaringContainer),
+                                     r->capacity * 2 * sizeof(RoaringContainer));
+        r->capacity *= 2;
+    }
+    memmove(&r->containers[pos + 1], &r->containers[pos], (r->count - pos) * sizeof(RoaringContainer));
+    r->count++;
+    RoaringContainer *c = &r->containers[pos];
+    c->key = key;
+    c->is_bitmap = 0;
+    c->cardinality = 0;
+    c->capacity = INITIAL_ARRAY_CAPACITY;
+    c->data.array = (uint16_t *)pool_alloc(pool, INITIAL_ARRAY_CAPACITY * sizeof(uint16_t));
+    return c;
+}
+
+// Posição do valor no vetor ordenado ou, se não existir, -(posição de inserção) - 1
+static int findInArray(const uint16_t *array, int count, uint16_t low16) {
+    if (count > 0 && array[count - 1] < low16)
+        return -count - 1;
+    int low = 0, high = count - 1;
+    while (low <= high) {
+        int mid = (low + high) / 2;
+        if (array[mid] < low16)
+            low = mid + 1;
+        else if (array[mid] > low16)
+            high = mid - 1;
+        else
+            return mid;
+    }
+    return -low - 1;
+}
+
+// Converte um contêiner de vetor cheio em mapa de bits
+static void toBitmap(RoaringContainer *c, Pool *pool) {
+    uint64_t *bits = (uint64_t *)pool_alloc(pool, ROARING_BITMAP_WORDS * sizeof(uint64_t));
+    memset(bits, 0, ROARING_BITMAP_WORDS * sizeof(uint64_t));
+    for (int i = 0; i < c->cardinality; i++)
+        bits[c->data.array[i] >> 6] |= (uint64_t)1 << (c->data.array[i] & 63);
+    c->data.bits = bits;
+    c->is_bitmap = 1;
+}
+
+void roaring_add(Roaring *r, uint32_t value, Pool *pool) {
+    uint16_t key = (uint16_t)(value >> 16), low16 = (uint16_t)value;
+    int pos = findContainer(r, key);
+    RoaringContainer *c = (pos >= 0) ? &r->containers[pos] : insertContainer(r, -pos - 1, key, pool);
+
+    if (c->is_bitmap) {
+        uint64_t mask = (uint64_t)1 << (low16 & 63);
+        if (c->data.bits[low16 >> 6] & mask)
+            return;
+        c->data.bits[low16 >> 6] |= mask;
+    } else {
+        int i = findInArray(c->data.array, c->cardinality, low16);
+        if (i >= 0)
+            return;
+        i = -i - 1;
+        if (c->cardinality >= ROARING_ARRAY_MAX) {
+            toBitmap(c, pool);
+            c->data.bits[low16 >> 6] |= (uint64_t)1 << (low16 & 63);
+        } else {
+            if (c->cardinality >= c->capacity) {
+                int capacity = c->capacity * 2;
+                if (capacity > ROARING_ARRAY_MAX)
+                    capacity = ROARING_ARRAY_MAX;
+                c->data.array = pool_realloc(pool, c->data.array, c->capacity * sizeof(uint16_t),
+                                             capacity * sizeof(uint16_t));
+                c->capacity = capacity;
+            }
+            memmove(&c->data.array[i + 1], &c->data.array[i], (c->cardinality - i) * sizeof(uint16_t));
+            c->data.array[i] = low16;
+        }
+    }
+    c->cardinality++;
+    r->cardinality++;
+    r->last = value;
+}
+
+int roaring_contains(const Roaring *r, uint32_t value) {
+    uint16_t low16 = (uint16_t)value;
+    int pos = findContainer(r, (uint16_t)(value >> 16));
+    if (pos < 0)
+        return 0;
+    const RoaringContainer *c = &r->containers[pos];
+    if (c->is_bitmap)
+        return (c->data.bits[low16 >> 6] >> (low16 & 63)) & 1;
+    return findInArray(c->data.array, c->cardinality, low16) >= 0;
+}
+
+// Quantidade de valores comuns a dois contêineres com a mesma chave
+static uint32_t andContainers(const RoaringContainer *a, const RoaringContainer *b) {
+    uint32_t total = 0;
+    if (a->is_bitmap && b->is_bitmap) {
+        for (int w = 0; w < ROARING_BITMAP_WORDS; w++)
+            total += (uint32_t)__builtin_popcountll(a->data.bits[w] & b->data.bits[w]);
+    } else if (a->is_bitmap || b->is_bitmap) {
+        const RoaringContainer *bitmap = a->is_bitmap ? a : b;
+        const RoaringContainer *array = a->is_bitmap ? b : a;
+        for (int i = 0; i < array->cardinality; i++) {
+            uint16_t v = array->data.array[i];
+            total += (bitmap->data.bits[v >> 6] >> (v & 63)) & 1;
+        }
+    } else {
+        // Merge de dois vetores ordenados
+        int i = 0, j = 0;
+        while (i < a->cardinality && j < b->cardinality) {
+            if (a->data.array[i] < b->data.array[j]) {
+                i++;
+            } else if (a->data.array[i] > b->data.array[j]) {
+                j++;
+            } else {
+                total++;
+                i++;
+                j++;
+            }
+        }
+    }
+    return total;
+}
+
+uint32_t roaring_and_cardinality(const Roaring *a, const Roaring *b) {
+    uint32_t total = 0;
+    int i = 0, j = 0;
+    while (i < a->count && j < b->count) {
+        if (a->containers[i].key < b->containers[j].key) {
+            i++;
+        } else if (a->containers[i].key > b->containers[j].key) {
+            j++;
+        } else {
+            total += andContainers(&a->containers[i], &b->containers[j]);
+            i++;
+            j++;
+        }
+    }
+    return total;
+}
+
+void roaring_foreach(const Roaring *r, RoaringVisitFn visit, void *ctx) {
+    for (int i = 0; i < r->count; i++) {
+        const RoaringContainer *c = &r->containers[i];
+        uint32_t high = (uint32_t)c->key << 16;
+        if (c->is_bitmap) {
+            for (int w = 0; w < ROARING_BITMAP_WORDS; w++) {
+                uint64_t word = c->data.bits[w];
+                while (word != 0) {
+                    int bit = __builtin_ctzll(word);
+                    visit(high | (uint32_t)(w * 64 + bit), ctx);
+                    word &= word - 1;
+                }
+            }
+        } else {
+            for (int k = 0; k < c->cardinality; k++)
+                visit(high | c->data.array[k], ctx);
+        }
+    }
+}
+
+size_t roaring_memory(const Roaring *r) {
+    size_t total = sizeof(Roaring) + r->capacity * sizeof(RoaringContainer);
+    for (int i = 0; i < r->count; i++) {
+        const RoaringContainer *c = &r->containers[i];
+        total += c->is_bitmap ? ROARING_BITMAP_WORDS * sizeof(uint64_t) : c->capacity * sizeof(uint16_t);
+    }
+    return total;
+}
@@ -0,0 +1,62 @@
+#ifndef ROARING_H
+#define ROARING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "pool.h"
+
+// Um contêiner de vetor passa a ser de bits quando ultrapassa este número de valores
+// (acima disso os 8 KB do mapa de bits ocupam menos que 2 bytes por valor)
+#define ROARING_ARRAY_MAX 4096
+
+// Palavras de 64 bits de um contêiner de bits (65536 bits)
+#define ROARING_BITMAP_WORDS 1024
+
+// Contêiner com os valores que têm os mesmos 16 bits altos (key). Guarda os 16 bits
+// baixos como vetor ordenado (poucos valores) ou como mapa de 65536 bits (muitos).
+typedef struct {
+    uint16_t key;            // 16 bits altos dos valores
+    uint16_t is_bitmap;      // 1 = mapa de bits, 0 = vetor ordenado
+    int32_t cardinality;     // Quantidade de valores
+    int32_t capacity;        // Capacidade do vetor (contêiner de vetor)
+    union {
+        uint16_t *array;     // 16 bits baixos, em ordem crescente
+        uint64_t *bits;      // ROARING_BITMAP_WORDS palavras
+    } data;
+} RoaringContainer;
+
+// Conjunto compactado de inteiros de 32 bits no estilo Roaring: os valores são
+// divididos em blocos de 65536 pela parte alta, e cada bloco escolhe a representação
+// mais compacta. Toda a memória vem de um pool (liberada junto com o índice).
+typedef struct Roaring {
+    RoaringContainer *containers;  // Em ordem crescente de key
+    int32_t count;                 // Contêineres em uso
+    int32_t capacity;              // Capacidade do vetor de contêineres
+    uint32_t cardinality;          // Total de valores
+    uint32_t last;                 // Último valor adicionado
+} Roaring;
+
+// Função chamada para cada valor do conjunto, em ordem crescente.
+typedef void (*RoaringVisitFn)(uint32_t value, void *ctx);
+
+// Cria um conjunto vazio no pool.
+Roaring* roaring_create(Pool *pool);
+
+// Adiciona um valor (sem efeito se já estiver no conjunto). Valores em ordem crescente
+// são o caso rápido: caem sempre no último contêiner.
+void roaring_add(Roaring *r, uint32_t value, Pool *pool);
+
+// Retorna 1 se o valor está no conjunto.
+int roaring_contains(const Roaring *r, uint32_t value);
+
+// Quantidade de valores presentes nos dois conjuntos (sem montar a interseção).
+// Mapas de bits são combinados com AND e contagem de bits de 64 em 64 valores.
+uint32_t roaring_and_cardinality(const Roaring *a, const Roaring *b);
+
+// Percorre os valores em ordem crescente.
+void roaring_foreach(const Roaring *r, RoaringVisitFn visit, void *ctx);
+
+// Memória ocupada pelo conjunto, em bytes.
+size_t roaring_memory(const Roaring *r);
+
+#endif // ROARING_H
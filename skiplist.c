@@ -0,0 +1,266 @@
+#define _GNU_SOURCE
+#include "skiplist.h"
+#include "postings.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// Capacidade do primeiro bloco de documentos de cada nó
+#define INITIAL_CHUNK_CAPACITY 4
+
+// Operações atômicas (builtins do GCC, disponíveis também em -std=c99)
+#define LOAD(ptr)            __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define STORE(ptr, val)      __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#define CAS(ptr, exp, val)   __atomic_compare_exchange_n((ptr), (exp), (val), 0, \
+                                                         __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#define FETCH_ADD(ptr, val)  __atomic_fetch_add((ptr), (val), __ATOMIC_ACQ_REL)
+
+// Sorteia a altura de um novo nó (cada nível extra com probabilidade 1/2), usando
+// um xorshift com a semente do escritor para não disputar estado com outras threads
+static int randomLevel(SkipWriter *w) {
+    unsigned int x = w->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    w->seed = x;
+    int level = 1;
+    while ((x & 1) && level < SKIPLIST_MAX_LEVEL) {
+        level++;
+        x >>= 1;
+    }
+    return level;
+}
+
+// Aloca um bloco de documentos vazio no pool do escritor
+static DocChunk* createChunk(Pool *pool, int capacity) {
+    DocChunk *chunk = (DocChunk *)pool_alloc(pool, sizeof(DocChunk) + capacity * sizeof(uint32_t));
+    chunk->next = NULL;
+    chunk->capacity = capacity;
+    chunk->count = 0;
+    return chunk;
+}
+
+// Aloca um nó com a palavra copiada logo em seguida (mesma linha de cache na comparação)
+static SkipNode* createSkipNode(Pool *pool, const char *word, int level) {
+    size_t len = strlen(word) + 1;
+    size_t size = sizeof(SkipNode) + level * sizeof(SkipNode *);
+    SkipNode *node = (SkipNode *)pool_alloc(pool, size + len);
+    char *copy = (char *)node + size;
+    memcpy(copy, word, len);
+    node->word = copy;
+    node->frequency = 0;
+    node->chunks = createChunk(pool, INITIAL_CHUNK_CAPACITY);
+    node->docs = NULL;
+    node->count_docs = 0;
+    node->bitmap = NULL;
+    node->level = level;
+    for (int i = 0; i < level; i++)
+        node->next[i] = NULL;
+    return node;
+}
+
+// Localiza, em cada nível, o último nó com palavra < word (preds) e o seguinte (succs).
+// Retorna o nó com a palavra, se ele existir.
+static SkipNode* findPosition(const SkipList *list, const char *word,
+                              SkipNode **preds, SkipNode **succs) {
+    SkipNode *x = list->head;
+    SkipNode *found = NULL;
+    for (int level = SKIPLIST_MAX_LEVEL - 1; level >= 0; level--) {
+        SkipNode *next = LOAD(&x->next[level]);
+        int cmp = -1;
+        while (next != NULL && (cmp = strcmp(next->word, word)) < 0) {
+            x = next;
+            next = LOAD(&x->next[level]);
+        }
+        if (next != NULL && cmp == 0)
+            found = next;
+        preds[level] = x;
+        succs[level] = next;
+    }
+    return found;
+}
+
+// Acrescenta um documento ao nó: reserva uma posição no bloco do topo com fetch-and-add;
+// se o bloco estiver cheio, empilha um bloco novo (que já contém o documento) via CAS
+static void appendDoc(SkipNode *node, SkipWriter *w, uint32_t doc) {
+    FETCH_ADD(&node->frequency, 1);
+    DocChunk *novo = NULL;
+    while (1) {
+        DocChunk *chunk = LOAD(&node->chunks);
+        int slot = FETCH_ADD(&chunk->count, 1);
+        if (slot < chunk->capacity) {
+            chunk->docs[slot] = doc;
+            return;
+        }
+        if (novo == NULL) {
+            novo = createChunk(&w->pool, chunk->capacity * 2);
+            novo->docs[0] = doc;
+            novo->count = 1;
+        }
+        novo->next = chunk;
+        if (CAS(&node->chunks, &chunk, novo))
+            return;
+        // Outra thread empilhou um bloco antes: tenta novamente no novo topo
+        // (o bloco alocado é reaproveitado na próxima tentativa, se necessário)
+    }
+}
+
+// Aloca os escritores alinhados a uma linha de cache (malloc só garante 16 bytes), para
+// que o estado de cada thread ocupe linhas próprias
+static SkipWriter* allocWriters(int writers) {
+    size_t size = (size_t)writers * sizeof(SkipWriter);
+#ifdef _WIN32
+    return (SkipWriter *)_aligned_malloc(size, SKIPLIST_CACHE_LINE);
+#else
+    void *mem;
+    return (posix_memalign(&mem, SKIPLIST_CACHE_LINE, size) == 0) ? (SkipWriter *)mem : NULL;
+#endif
+}
+
+static void freeWriters(SkipWriter *writers) {
+#ifdef _WIN32
+    _aligned_free(writers);
+#else
+    free(writers);
+#endif
+}
+
+void skiplist_init(SkipList *list, int writers) {
+    if (writers < 1)
+        writers = 1;
+    list->writers = allocWriters(writers);
+    if (list->writers == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para os escritores da skip list.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < writers; i++) {
+        pool_init(&list->writers[i].pool, POOL_SLAB_SIZE);
+        list->writers[i].seed = 2463534242u + 7919u * (unsigned int)i;
+    }
+    list->writer_count = writers;
+    list->head = createSkipNode(&list->writers[0].pool, "", SKIPLIST_MAX_LEVEL);
+    list->size = 0;
+}
+
+void skiplist_insert(SkipList *list, int writer, const char *word, uint32_t doc) {
+    SkipWriter *w = &list->writers[writer];
+    SkipNode *preds[SKIPLIST_MAX_LEVEL];
+    SkipNode *succs[SKIPLIST_MAX_LEVEL];
+    SkipNode *node = NULL;
+
+    while (1) {
+        SkipNode *found = findPosition(list, word, preds, succs);
+        if (found != NULL) {
+            // A palavra já existe (ou outra thread acabou de inseri-la)
+            appendDoc(found, w, doc);
+            return;
+        }
+        if (node == NULL)
+            node = createSkipNode(&w->pool, word, randomLevel(w));
+        // O nó passa a existir quando é ligado no nível 0
+        node->next[0] = succs[0];
+        SkipNode *esperado = succs[0];
+        if (CAS(&preds[0]->next[0], &esperado, node))
+            break;
+        // Outra thread alterou a vizinhança: procura novamente
+    }
+
+    appendDoc(node, w, doc);
+    FETCH_ADD(&list->size, 1);
+
+    // Liga os níveis superiores (apenas atalhos: a busca já encontra o nó pelo nível 0)
+    for (int level = 1; level < node->level; level++) {
+        while (1) {
+            STORE(&node->next[level], succs[level]);
+            SkipNode *esperado = succs[level];
+            if (CAS(&preds[level]->next[level], &esperado, node))
+                break;
+            findPosition(list, word, preds, succs);
+        }
+    }
+}
+
+// Ordena documentos em ordem crescente
+static int compareDoc(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+void skiplist_finish(SkipList *list) {
+    Pool *pool = &list->writers[0].pool;
+    uint32_t *buffer = NULL;
+    int capacity = 0;
+    for (SkipNode *n = list->head->next[0]; n != NULL; n = n->next[0]) {
+        int total = 0;
+        for (DocChunk *c = n->chunks; c != NULL; c = c->next)
+            total += (c->count < c->capacity) ? c->count : c->capacity;
+        if (total > capacity) {
+            capacity = total;
+            buffer = (uint32_t *)realloc(buffer, capacity * sizeof(uint32_t));
+            if (buffer == NULL) {
+                fprintf(stderr, "Erro ao alocar memória para os documentos da skip list.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        int k = 0;
+        for (DocChunk *c = n->chunks; c != NULL; c = c->next) {
+            int usados = (c->count < c->capacity) ? c->count : c->capacity;
+            memcpy(buffer + k, c->docs, usados * sizeof(uint32_t));
+            k += usados;
+        }
+        // Threads diferentes intercalam os documentos: restaura a ordem do arquivo
+        // e descarta as repetições (várias ocorrências na mesma linha)
+        qsort(buffer, total, sizeof(uint32_t), compareDoc);
+        int distintos = 0;
+        for (int i = 0; i < total; i++) {
+            if (distintos == 0 || buffer[distintos - 1] != buffer[i])
+                buffer[distintos++] = buffer[i];
+        }
+        if (distintos >= POSTINGS_BITMAP_MIN) {
+            n->bitmap = roaring_create(pool);
+            for (int i = 0; i < distintos; i++)
+                roaring_add(n->bitmap, buffer[i], pool);
+        } else {
+            uint32_t *docs = (uint32_t *)pool_alloc(pool, distintos * sizeof(uint32_t));
+            memcpy(docs, buffer, distintos * sizeof(uint32_t));
+            n->docs = docs;
+        }
+        n->count_docs = distintos;
+        n->chunks = NULL;
+    }
+    free(buffer);
+}
+
+// Primeiro nó com palavra >= word (ou NULL)
+static SkipNode* lowerBound(const SkipList *list, const char *word) {
+    SkipNode *x = list->head;
+    for (int level = SKIPLIST_MAX_LEVEL - 1; level >= 0; level--) {
+        SkipNode *next = LOAD(&x->next[level]);
+        while (next != NULL && strcmp(next->word, word) < 0) {
+            x = next;
+            next = LOAD(&x->next[level]);
+        }
+    }
+    return LOAD(&x->next[0]);
+}
+
+SkipNode* skiplist_search(const SkipList *list, const char *word) {
+    SkipNode *n = lowerBound(list, word);
+    if (n != NULL && strcmp(n->word, word) == 0)
+        return n;
+    return NULL;
+}
+
+void skiplist_free(SkipList *list) {
+    for (int i = 0; i < list->writer_count; i++)
+        pool_destroy(&list->writers[i].pool);
+    freeWriters(list->writers);
+    list->writers = NULL;
+    list->writer_count = 0;
+    list->head = NULL;
+    list->size = 0;
+}
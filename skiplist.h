@@ -0,0 +1,72 @@
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
+#include <stdint.h>
+#include "pool.h"
+#include "roaring.h"
+
+// Altura máxima de um nó (suficiente para dezenas de milhões de palavras com p = 1/2)
+#define SKIPLIST_MAX_LEVEL 24
+
+// Bloco de documentos de um nó. Os blocos formam uma pilha lock-free: quando o bloco
+// do topo enche, uma thread empilha um bloco novo (com o dobro da capacidade) via CAS.
+typedef struct DocChunk {
+    struct DocChunk *next;       // Bloco anterior (mais antigo)
+    int capacity;                // Capacidade de documentos
+    int count;                   // Posições reservadas (pode passar de capacity; atômico)
+    uint32_t docs[];
+} DocChunk;
+
+// Nó da skip list. Os campos marcados como atômicos são alterados por várias threads
+// durante a carga; após skiplist_finish os documentos ficam ordenados e sem repetição,
+// em um vetor contíguo (palavras raras) ou em um conjunto compactado (palavras comuns).
+typedef struct SkipNode {
+    const char *word;            // Palavra (copiada logo após o nó)
+    int frequency;               // Frequência da palavra (atômico durante a carga)
+    DocChunk *chunks;            // Pilha de blocos de documentos (atômico; NULL após finish)
+    const uint32_t *docs;        // Documentos contíguos e ordenados (após finish; NULL se bitmap)
+    int count_docs;              // Quantidade de documentos distintos (válido após finish)
+    Roaring *bitmap;             // Documentos compactados (após finish; NULL se docs)
+    int level;                   // Quantidade de níveis do nó
+    struct SkipNode *next[];     // Próximo nó em cada nível (atômico)
+} SkipNode;
+
+// Tamanho de uma linha de cache
+#define SKIPLIST_CACHE_LINE 64
+
+// Estado privado de cada thread escritora: pool próprio (sem disputa pelo alocador)
+// e semente do gerador de níveis. O tamanho é múltiplo de uma linha de cache e o vetor
+// de escritores é alocado alinhado (skiplist_init), para evitar falso compartilhamento.
+typedef struct {
+    Pool pool;
+    unsigned int seed;
+    char padding[SKIPLIST_CACHE_LINE - (sizeof(Pool) + sizeof(unsigned int)) % SKIPLIST_CACHE_LINE];
+} SkipWriter;
+
+// Skip list ordenada por palavra que aceita inserções concorrentes sem locks:
+// os nós são ligados com compare-and-swap, nível a nível, e não há remoção.
+typedef struct {
+    SkipNode *head;              // Sentinela com SKIPLIST_MAX_LEVEL níveis
+    SkipWriter *writers;         // Um estado por thread escritora
+    int writer_count;            // Quantidade de escritores
+    int size;                    // Número de palavras distintas (atômico)
+} SkipList;
+
+// Inicializa uma skip list vazia que aceita até 'writers' threads escritoras.
+void skiplist_init(SkipList *list, int writers);
+
+// Insere uma ocorrência da palavra. Pode ser chamada ao mesmo tempo por várias threads,
+// desde que cada uma use um índice de escritor diferente (0 <= writer < writer_count).
+void skiplist_insert(SkipList *list, int writer, const char *word, uint32_t doc);
+
+// Conclui a carga (depois que todas as threads escritoras terminaram): junta os blocos
+// de documentos de cada nó, ordenando e removendo repetições.
+void skiplist_finish(SkipList *list);
+
+// Pesquisa a palavra e retorna o nó correspondente ou NULL se não encontrar.
+SkipNode* skiplist_search(const SkipList *list, const char *word);
+
+// Libera a skip list, devolvendo os pools dos escritores.
+void skiplist_free(SkipList *list);
+
+#endif // SKIPLIST_H
@@ -0,0 +1,118 @@
+#include "splay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Cria um novo nó splay para a palavra (alocado do pool)
+static SplayNode* createSplayNode(const char *prefix, const char *word, uint32_t doc, TreePool *pool) {
+    SplayNode *node = (SplayNode *)pool_alloc(&pool->nodes, sizeof(SplayNode));
+    memcpy(node->prefix, prefix, KEY_PREFIX_LEN);
+    // Palavras curtas cabem no prefixo e não precisam de cópia separada
+    const char *full = key_is_inline(node->prefix) ? node->prefix : pool_strdup(&pool->postings, word);
+    node->postings = postings_create(&pool->postings, full, doc);
+    node->left = node->right = NULL;
+    return node;
+}
+
+// Compara a palavra (com prefixo já calculado) com a chave do nó
+static int compareNode(const char *prefix, const char *word, const SplayNode *node) {
+    return key_compare(prefix, word, node->prefix, &node->postings->word);
+}
+
+// Splay top-down: leva até a raiz o nó com a palavra (ou o último nó visitado,
+// se a palavra não existir) e retorna a nova raiz.
+static SplayNode* splay(SplayNode *t, const char *prefix, const char *word) {
+    if (t == NULL)
+        return NULL;
+    SplayNode header;           // Raiz temporária das árvores "esquerda" e "direita"
+    header.left = header.right = NULL;
+    SplayNode *l = &header, *r = &header;
+
+    while (1) {
+        int cmp = compareNode(prefix, word, t);
+        if (cmp < 0) {
+            if (t->left == NULL)
+                break;
+            if (compareNode(prefix, word, t->left) < 0) {
+                // Zig-zig: rotação à direita
+                SplayNode *y = t->left;
+                t->left = y->right;
+                y->right = t;
+                t = y;
+                if (t->left == NULL)
+                    break;
+            }
+            // Liga t à árvore da direita
+            r->left = t;
+            r = t;
+            t = t->left;
+        } else if (cmp > 0) {
+            if (t->right == NULL)
+                break;
+            if (compareNode(prefix, word, t->right) > 0) {
+                // Zag-zag: rotação à esquerda
+                SplayNode *y = t->right;
+                t->right = y->left;
+                y->left = t;
+                t = y;
+                if (t->right == NULL)
+                    break;
+            }
+            // Liga t à árvore da esquerda
+            l->right = t;
+            l = t;
+            t = t->right;
+        } else {
+            break;
+        }
+    }
+    // Remonta: as árvores esquerda e direita viram os filhos da nova raiz
+    l->right = t->left;
+    r->left = t->right;
+    t->left = header.right;
+    t->right = header.left;
+    return t;
+}
+
+// Insere ou atualiza a palavra na árvore splay
+SplayNode* splay_insert(SplayNode *root, const char *word, uint32_t doc, TreePool *pool) {
+    char prefix[KEY_PREFIX_LEN];
+    key_make_prefix(prefix, word);
+    if (root == NULL)
+        return createSplayNode(prefix, word, doc, pool);
+
+    root = splay(root, prefix, word);
+    int cmp = compareNode(prefix, word, root);
+    if (cmp == 0) {
+        // Palavra já existe: atualiza a frequência e adiciona o documento
+        postings_add(root->postings, doc, &pool->postings);
+        return root;
+    }
+    // A nova palavra vira a raiz, dividindo a árvore antiga entre seus filhos
+    SplayNode *node = createSplayNode(prefix, word, doc, pool);
+    if (cmp < 0) {
+        node->left = root->left;
+        node->right = root;
+        root->left = NULL;
+    } else {
+        node->right = root->right;
+        node->left = root;
+        root->right = NULL;
+    }
+    return node;
+}
+
+// Pesquisa a palavra, trazendo-a para a raiz
+SplayNode* splay_search(SplayNode **root, const char *word) {
+    char prefix[KEY_PREFIX_LEN];
+    key_make_prefix(prefix, word);
+    *root = splay(*root, prefix, word);
+    if (*root != NULL && compareNode(prefix, word, *root) == 0)
+        return *root;
+    return NULL;
+}
+
+// Libera a memória da árvore splay: basta devolver os slabs do pool
+void splay_free(TreePool *pool) {
+    tree_pool_destroy(pool);
+}
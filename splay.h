@@ -0,0 +1,32 @@
+#ifndef SPLAY_H
+#define SPLAY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pool.h"
+#include "postings.h"
+#include "word_key.h"
+
+// Estrutura do nó da Árvore Splay (mesmo layout compacto da BST)
+// A cada acesso o nó buscado é levado até a raiz, então palavras consultadas com
+// frequência ficam perto do topo e são encontradas com poucas comparações.
+typedef struct SplayNode {
+    char prefix[KEY_PREFIX_LEN]; // Primeiros bytes da palavra (completados com '\0')
+    struct SplayNode *left;  // Ponteiro para filho à esquerda
+    struct SplayNode *right; // Ponteiro para filho à direita
+    Postings *postings;      // Palavra completa, frequência e documentos
+} SplayNode;
+
+// Insere (ou atualiza) uma palavra na árvore splay e retorna a nova raiz
+// (o nó da palavra passa a ser a raiz).
+SplayNode* splay_insert(SplayNode *root, const char *word, uint32_t doc, TreePool *pool);
+
+// Pesquisa uma palavra e reorganiza a árvore (*root é atualizada). Retorna o nó
+// encontrado (que passa a ser a raiz) ou NULL se não encontrar.
+SplayNode* splay_search(SplayNode **root, const char *word);
+
+// Libera a memória alocada para a árvore splay, devolvendo os slabs do pool.
+void splay_free(TreePool *pool);
+
+#endif // SPLAY_H
@@ -0,0 +1,324 @@
+#define _GNU_SOURCE
+#include "stream.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+#endif
+
+// Comandos que descompactam um arquivo para a saída padrão
+static const char *DECOMPRESSORS[] = { NULL, "gzip", "zstd" };
+static const char *FORMAT_NAMES[] = { "texto", "gzip", "zstd" };
+
+// Tempo de relógio em segundos
+static double wallTime(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+StreamFormat stream_detect(const char *path) {
+    if (strcmp(path, "-") == 0)
+        return STREAM_PLAIN;
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL)
+        return STREAM_PLAIN;
+    unsigned char magic[4];
+    size_t n = fread(magic, 1, sizeof(magic), fp);
+    fclose(fp);
+    if (n >= 2 && magic[0] == 0x1F && magic[1] == 0x8B)
+        return STREAM_GZIP;
+    if (n == 4 && magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F && magic[3] == 0xFD)
+        return STREAM_ZSTD;
+    return STREAM_PLAIN;
+}
+
+const char* stream_format_name(StreamFormat format) {
+    return FORMAT_NAMES[format];
+}
+
+#ifdef _WIN32
+// Sem fork no Windows: o descompactador é iniciado pelo interpretador de comandos, com o
+// nome do arquivo entre aspas (nomes de arquivo do Windows não podem conter aspas)
+static int spawnDecompressor(StreamSource *src, const char *path) {
+    char cmd[4096];
+    int n = snprintf(cmd, sizeof(cmd), "%s -dc -- \"%s\"", DECOMPRESSORS[src->format], path);
+    if (n < 0 || (size_t)n >= sizeof(cmd))
+        return 0;
+    src->fp = _popen(cmd, "rb");
+    src->is_pipe = src->fp != NULL;
+    return src->fp != NULL;
+}
+#else
+// Inicia o descompactador com a saída ligada a um pipe (sem passar pelo shell, então o
+// nome do arquivo não precisa de escape)
+static int spawnDecompressor(StreamSource *src, const char *path) {
+    int fds[2];
+    if (pipe(fds) != 0)
+        return 0;
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return 0;
+    }
+    if (pid == 0) {
+        dup2(fds[1], STDOUT_FILENO);
+        close(fds[0]);
+        close(fds[1]);
+        const char *cmd = DECOMPRESSORS[src->format];
+        execlp(cmd, cmd, "-dc", "--", path, (char *)NULL);
+        fprintf(stderr, "Erro ao executar o descompactador '%s'.\n", cmd);
+        _exit(127);
+    }
+    close(fds[1]);
+    src->fp = fdopen(fds[0], "r");
+    src->pid = pid;
+    return src->fp != NULL;
+}
+#endif
+
+// Nenhum processo associado à fonte
+static void clearProcess(StreamSource *src) {
+#ifdef _WIN32
+    src->is_pipe = 0;
+#else
+    src->pid = 0;
+#endif
+}
+
+int stream_open(StreamSource *src, const char *path) {
+    src->fp = NULL;
+    clearProcess(src);
+    src->is_stdin = 0;
+    src->format = stream_detect(path);
+    if (src->format == STREAM_PLAIN) {
+        src->fp = fopen(path, "r");
+    } else if (!spawnDecompressor(src, path)) {
+        src->fp = NULL;
+    }
+    if (src->fp == NULL) {
+        fprintf(stderr, "Erro ao abrir o arquivo %s.\n", path);
+        return 0;
+    }
+    return 1;
+}
+
+void stream_attach_stdin(StreamSource *src) {
+    clearProcess(src);
+    src->format = STREAM_PLAIN;
+    src->is_stdin = 1;
+#ifdef _WIN32
+    int fd = _dup(_fileno(stdin));
+    src->fp = (fd >= 0) ? _fdopen(fd, "r") : NULL;
+#else
+    int fd = dup(STDIN_FILENO);
+    src->fp = (fd >= 0) ? fdopen(fd, "r") : NULL;
+#endif
+    if (src->fp == NULL) {
+        fprintf(stderr, "Erro ao separar a entrada padrao.\n");
+        exit(EXIT_FAILURE);
+    }
+    // O menu passa a ler do terminal; sem terminal, stdin fica em EOF
+#ifdef _WIN32
+    if (freopen("CON", "r", stdin) == NULL)
+        freopen("NUL", "r", stdin);
+#else
+    if (freopen("/dev/tty", "r", stdin) == NULL) {
+        int vazio = open("/dev/null", O_RDONLY);
+        if (vazio >= 0) {
+            dup2(vazio, STDIN_FILENO);
+            close(vazio);
+        }
+    }
+#endif
+}
+
+int stream_close(StreamSource *src) {
+    int ok = 1;
+#ifdef _WIN32
+    if (src->fp != NULL && src->is_pipe) {
+        if (_pclose(src->fp) != 0) {
+            fprintf(stderr, "Erro ao descompactar a entrada (%s).\n", stream_format_name(src->format));
+            ok = 0;
+        }
+    } else if (src->fp != NULL) {
+        fclose(src->fp);
+    }
+#else
+    if (src->fp != NULL)
+        fclose(src->fp);
+    if (src->pid > 0) {
+        int status;
+        if (waitpid(src->pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            fprintf(stderr, "Erro ao descompactar a entrada (%s).\n", stream_format_name(src->format));
+            ok = 0;
+        }
+    }
+#endif
+    src->fp = NULL;
+    clearProcess(src);
+    return ok;
+}
+
+// Dois buffers trocados entre a thread leitora e o indexador. A leitora preenche os
+// buffers alternadamente (0, 1, 0, ...) e o indexador os consome na mesma ordem.
+typedef struct {
+    char *data[2];
+    size_t size[2];              // Bytes válidos em cada buffer
+    int full[2];                 // 1 = aguardando o indexador
+    int done;                    // A leitora terminou (todos os buffers já entregues)
+    int error;                   // Erro de leitura
+    pthread_mutex_t mutex;
+    pthread_cond_t changed;
+    FILE *fp;
+    double reader_wait;
+} Pipeline;
+
+// Corpo da thread leitora
+static void* readChunks(void *arg) {
+    Pipeline *p = (Pipeline *)arg;
+    for (int i = 0; ; i ^= 1) {
+        pthread_mutex_lock(&p->mutex);
+        if (p->full[i]) {
+            double inicio = wallTime();
+            while (p->full[i])
+                pthread_cond_wait(&p->changed, &p->mutex);
+            p->reader_wait += wallTime() - inicio;
+        }
+        pthread_mutex_unlock(&p->mutex);
+
+        size_t n = fread(p->data[i], 1, STREAM_CHUNK, p->fp);
+
+        pthread_mutex_lock(&p->mutex);
+        p->size[i] = n;
+        if (n > 0)
+            p->full[i] = 1;
+        if (n < STREAM_CHUNK) {
+            p->done = 1;
+            p->error = ferror(p->fp);
+        }
+        pthread_cond_broadcast(&p->changed);
+        int fim = p->done;
+        pthread_mutex_unlock(&p->mutex);
+        if (fim)
+            return NULL;
+    }
+}
+
+// Linha em montagem: uma linha pode começar em um buffer e terminar no seguinte
+typedef struct {
+    char *text;
+    size_t len;
+    size_t capacity;
+} LineBuffer;
+
+static void appendBytes(LineBuffer *line, const char *bytes, size_t n) {
+    if (line->len + n + 1 > line->capacity) {
+        while (line->len + n + 1 > line->capacity)
+            line->capacity *= 2;
+        line->text = realloc(line->text, line->capacity);
+        if (line->text == NULL) {
+            fprintf(stderr, "Erro ao realocar memória para a linha.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    memcpy(line->text + line->len, bytes, n);
+    line->len += n;
+}
+
+// Entrega a linha montada (sem '\r' e sem o BOM UTF-8 da primeira linha)
+static void emitLine(LineBuffer *line, StreamLineFn fn, void *ctx, StreamStats *stats) {
+    char *text = line->text;
+    size_t len = line->len;
+    if (len > 0 && text[len - 1] == '\r')
+        len--;
+    if (stats->lines == 0 && len >= 3 && (unsigned char)text[0] == 0xEF &&
+        (unsigned char)text[1] == 0xBB && (unsigned char)text[2] == 0xBF) {
+        text += 3;
+        len -= 3;
+    }
+    text[len] = '\0';
+    fn(text, len, ctx);
+    stats->lines++;
+    line->len = 0;
+}
+
+int stream_read_lines(StreamSource *src, StreamLineFn fn, void *ctx, StreamStats *stats) {
+    memset(stats, 0, sizeof(StreamStats));
+    double inicio = wallTime();
+
+    Pipeline p;
+    memset(&p, 0, sizeof(p));
+    p.fp = src->fp;
+    p.data[0] = (char *)malloc(STREAM_CHUNK);
+    p.data[1] = (char *)malloc(STREAM_CHUNK);
+    LineBuffer line = {(char *)malloc(1024), 0, 1024};
+    if (p.data[0] == NULL || p.data[1] == NULL || line.text == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para os buffers de leitura.\n");
+        exit(EXIT_FAILURE);
+    }
+    pthread_mutex_init(&p.mutex, NULL);
+    pthread_cond_init(&p.changed, NULL);
+    pthread_t leitora;
+    if (pthread_create(&leitora, NULL, readChunks, &p) != 0) {
+        fprintf(stderr, "Erro ao criar a thread leitora.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = 0; ; i ^= 1) {
+        pthread_mutex_lock(&p.mutex);
+        if (!p.full[i] && !p.done) {
+            double espera = wallTime();
+            while (!p.full[i] && !p.done)
+                pthread_cond_wait(&p.changed, &p.mutex);
+            stats->indexer_wait += wallTime() - espera;
+        }
+        int cheio = p.full[i];
+        pthread_mutex_unlock(&p.mutex);
+        if (!cheio)
+            break; // Fim: os buffers são consumidos na ordem em que foram preenchidos
+
+        // Separa as linhas do buffer; o pedaço final fica para o próximo
+        const char *pos = p.data[i];
+        const char *fim = p.data[i] + p.size[i];
+        while (pos < fim) {
+            const char *nl = memchr(pos, '\n', fim - pos);
+            if (nl == NULL) {
+                appendBytes(&line, pos, fim - pos);
+                break;
+            }
+            appendBytes(&line, pos, nl - pos);
+            emitLine(&line, fn, ctx, stats);
+            pos = nl + 1;
+        }
+        stats->bytes += p.size[i];
+        stats->chunks++;
+
+        pthread_mutex_lock(&p.mutex);
+        p.full[i] = 0;
+        pthread_cond_broadcast(&p.changed);
+        pthread_mutex_unlock(&p.mutex);
+    }
+    if (line.len > 0)
+        emitLine(&line, fn, ctx, stats); // Última linha sem '\n'
+
+    pthread_join(leitora, NULL);
+    stats->reader_wait = p.reader_wait;
+    stats->total = wallTime() - inicio;
+    pthread_mutex_destroy(&p.mutex);
+    pthread_cond_destroy(&p.changed);
+    free(p.data[0]);
+    free(p.data[1]);
+    free(line.text);
+    if (p.error)
+        fprintf(stderr, "Erro de leitura da entrada.\n");
+    return !p.error;
+}
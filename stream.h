@@ -0,0 +1,70 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stdio.h>
+#include <stddef.h>
+#ifndef _WIN32
+#include <sys/types.h>
+#endif
+
+// Tamanho de cada um dos dois buffers trocados entre a thread leitora e o indexador
+#define STREAM_CHUNK (256 * 1024)
+
+// Formato dos dados de entrada (detectado pelos primeiros bytes do arquivo)
+typedef enum {
+    STREAM_PLAIN = 0,        // Texto (CSV) sem compactação
+    STREAM_GZIP,             // gzip (descompactado por 'gzip -dc')
+    STREAM_ZSTD              // zstd (descompactado por 'zstd -dc')
+} StreamFormat;
+
+// Origem de uma carga em fluxo: a entrada padrão ou um arquivo, lido diretamente
+// ou pela saída de um processo descompactador.
+typedef struct {
+    FILE *fp;                // Dados já descompactados
+#ifdef _WIN32
+    int is_pipe;             // 1 = fp veio de _popen (descompactador)
+#else
+    pid_t pid;               // Processo descompactador (0 se não houver)
+#endif
+    StreamFormat format;
+    int is_stdin;            // 1 = entrada padrão (só pode ser lida uma vez)
+} StreamSource;
+
+// Medidas de uma leitura em fluxo.
+typedef struct {
+    long long bytes;         // Bytes lidos (já descompactados)
+    long chunks;             // Buffers entregues ao indexador
+    long lines;              // Linhas entregues ao indexador
+    double reader_wait;      // Tempo em que a leitora esperou um buffer livre (s)
+    double indexer_wait;     // Tempo em que o indexador esperou dados (s)
+    double total;            // Tempo total da leitura (s)
+} StreamStats;
+
+// Função chamada para cada linha lida (sem o '\n' e o '\r', terminada em '\0'). A linha
+// pode ser alterada; ela só vale até o retorno da função.
+typedef void (*StreamLineFn)(char *line, size_t len, void *ctx);
+
+// Formato do arquivo pelos primeiros bytes ("-" é a entrada padrão, sempre STREAM_PLAIN).
+StreamFormat stream_detect(const char *path);
+
+// Nome legível do formato.
+const char* stream_format_name(StreamFormat format);
+
+// Abre o arquivo para leitura em fluxo, iniciando o descompactador se for preciso.
+// Retorna 1 em caso de sucesso, 0 caso contrário.
+int stream_open(StreamSource *src, const char *path);
+
+// Separa a entrada padrão para ser lida como fonte de dados e reabre stdin no terminal
+// (/dev/tty, ou CON no Windows), para que o menu continue interativo. Sem terminal,
+// stdin fica em EOF.
+void stream_attach_stdin(StreamSource *src);
+
+// Lê a fonte até o fim e chama fn para cada linha. Uma thread leitora preenche um buffer
+// enquanto a thread chamadora separa as linhas do outro. Retorna 1 em caso de sucesso,
+// 0 em erro de leitura.
+int stream_read_lines(StreamSource *src, StreamLineFn fn, void *ctx, StreamStats *stats);
+
+// Fecha a fonte e aguarda o descompactador. Retorna 1 se ele terminou sem erro.
+int stream_close(StreamSource *src);
+
+#endif // STREAM_H
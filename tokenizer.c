@@ -0,0 +1,70 @@
+#define _GNU_SOURCE
+#include "tokenizer.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+
+int read_line_chunk(FILE *fp, char linha[MAX_LINE], int *fim_linha) {
+    // Se o buffer não encheu, fgets parou no '\n' (ou no fim do arquivo) e não tocou no
+    // último byte; se encheu, o último caractere diz se a linha terminou
+    linha[MAX_LINE - 1] = 1;
+    if (fgets(linha, MAX_LINE, fp) == NULL)
+        return 0;
+    *fim_linha = (linha[MAX_LINE - 1] != '\0' || linha[MAX_LINE - 2] == '\n');
+    return 1;
+}
+
+void str_to_lower(char *str) {
+    for (int i = 0; str[i]; i++) {
+        if ((unsigned char)str[i] < 128) {
+            str[i] = tolower((unsigned char)str[i]);
+        }
+        // se o caractere for >=128, presumimos que já está em caixa adequada
+    }
+}
+
+void remove_punctuation(char *str) {
+    int i = 0, j = 0;
+    while (str[i]) {
+        if ((unsigned char)str[i] < 128) {
+            if (isalnum((unsigned char)str[i]) || isspace((unsigned char)str[i])) {
+                str[j++] = str[i];
+            }
+        } else {
+            str[j++] = str[i];
+        }
+        i++;
+    }
+    str[j] = '\0';
+}
+
+void tokenize_line(char *linha, uint32_t doc, TokenFn fn, void *ctx) {
+    char *resto;
+    char *citacao;
+    if (linha[0] == '\"') {
+        char *fimCitacao = strchr(linha + 1, '\"');
+        if (fimCitacao != NULL) {
+            *fimCitacao = '\0';
+            citacao = linha + 1;
+        } else {
+            citacao = linha + 1;
+        }
+    } else {
+        citacao = strtok_r(linha, ",", &resto);
+    }
+    if (citacao == NULL)
+        return;
+
+    char citacaoProcessada[MAX_LINE];
+    strcpy(citacaoProcessada, citacao);
+    remove_punctuation(citacaoProcessada);
+    str_to_lower(citacaoProcessada);
+
+    char *token = strtok_r(citacaoProcessada, " ", &resto);
+    while (token != NULL) {
+        if (strlen(token) > MIN_WORD_LEN)
+            fn(token, doc, ctx);
+        token = strtok_r(NULL, " ", &resto);
+    }
+}
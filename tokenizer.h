@@ -0,0 +1,34 @@
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+// Tamanho máximo de uma linha lida do arquivo de citações
+#define MAX_LINE 1024
+
+// Tamanho mínimo (exclusivo) das palavras indexadas: palavras com 3 ou menos
+// caracteres são ignoradas
+#define MIN_WORD_LEN 3
+
+// Lê um pedaço de linha com fgets (linhas maiores que MAX_LINE - 1 bytes chegam em
+// vários pedaços) e informa em *fim_linha se ele terminou a linha. Retorna 0 no fim do
+// arquivo. Um '\0' dentro da linha não engana o teste, que não usa strlen.
+int read_line_chunk(FILE *fp, char linha[MAX_LINE], int *fim_linha);
+
+// Função chamada para cada palavra indexável de uma linha.
+typedef void (*TokenFn)(const char *token, uint32_t doc, void *ctx);
+
+// Converte uma string para minúsculo (para caracteres ASCII)
+// Note: caracteres multibyte (acima de 127) não são alterados.
+void str_to_lower(char *str);
+
+// Remove pontuação para acabar com erros de leitura
+void remove_punctuation(char *str);
+
+// Extrai a citação de uma linha do CSV (sem o '\n'), normaliza o texto e chama fn
+// para cada palavra com mais de MIN_WORD_LEN caracteres. A linha é modificada.
+// Não usa estado global, então pode ser chamada por várias threads ao mesmo tempo.
+void tokenize_line(char *linha, uint32_t doc, TokenFn fn, void *ctx);
+
+#endif // TOKENIZER_H
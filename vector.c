@@ -3,15 +3,48 @@
 #include <stdlib.h>
 #include <string.h>
 #include "vector.h"
+#include "mphf.h"
 
-// Tamanho inicial padrão para o vetor dinâmico de WordEntry e para os offsets
+// Tamanho inicial padrão para o vetor dinâmico de WordEntry e para os documentos
 #define INITIAL_VECTOR_CAPACITY 100
-#define INITIAL_OFFSET_CAPACITY 10
+#define INITIAL_DOC_CAPACITY 10
+
+// Tamanho dos níveis da hash perfeita em relação às chaves restantes
+#define VECTOR_MPHF_GAMMA 2.0
+
+// Ordem alfabética das entradas (a ordem da busca binária)
+static int compareEntry(const void *a, const void *b) {
+    return strcmp(((const WordEntry *)a)->word, ((const WordEntry *)b)->word);
+}
+
+static int compareEntryPtr(const void *a, const void *b) {
+    return compareEntry(*(const WordEntry * const *)a, *(const WordEntry * const *)b);
+}
+
+// Libera a hash perfeita sem mexer nas entradas
+static void dropHash(Vector *vec) {
+    if (vec->mphf != NULL) {
+        mphf_free(vec->mphf);
+        free(vec->mphf);
+    }
+    vec->mphf = NULL;
+}
+
+// Descarta a hash perfeita e devolve as entradas à ordem alfabética (o vocabulário vai
+// mudar e as inserções usam a busca binária)
+static void thawVector(Vector *vec) {
+    if (vec->mphf == NULL)
+        return;
+    dropHash(vec);
+    qsort(vec->entries, vec->size, sizeof(WordEntry), compareEntry);
+}
 
 // Inicializa o vetor
 void initVector(Vector *vec) {
     vec->size = 0;
     vec->capacity = INITIAL_VECTOR_CAPACITY;
+    vec->mphf = NULL;
+    pool_init(&vec->bitmaps, POOL_SLAB_SIZE);
     vec->entries = (WordEntry *)malloc(vec->capacity * sizeof(WordEntry));
     if (vec->entries == NULL) {
         fprintf(stderr, "Erro ao alocar memória para o vetor.\n");
@@ -21,11 +54,13 @@ void initVector(Vector *vec) {
 
 // Libera a memória de cada entrada e do vetor
 void freeVector(Vector *vec) {
+    dropHash(vec);
     for (int i = 0; i < vec->size; i++) {
         free(vec->entries[i].word);
-        free(vec->entries[i].offsets);
+        free(vec->entries[i].docs);
     }
     free(vec->entries);
+    pool_destroy(&vec->bitmaps);
     // Reseta campos do vetor após liberar memória
     vec->entries = NULL;
     vec->size = 0;
@@ -52,22 +87,57 @@ int vector_binary_search(Vector *vec, const char *word, int *found) {
 }
 
 // Insere ou atualiza uma palavra no vetor
-void vector_insert(Vector *vec, const char *word, long offset) {
+// Acrescenta o documento à lista da entrada (que já contém a palavra)
+static void addDoc(Vector *vec, WordEntry *entry, uint32_t doc) {
+    if (entry->bitmap != NULL) {
+        roaring_add(entry->bitmap, doc, &vec->bitmaps);
+        entry->count_docs = (int)entry->bitmap->cardinality;
+        return;
+    }
+    if (entry->docs[entry->count_docs - 1] == doc)
+        return; // Outra ocorrência na mesma linha
+    if (entry->count_docs == POSTINGS_BITMAP_MIN - 1) {
+        // Palavra comum: troca o vetor pelo conjunto compactado
+        entry->bitmap = roaring_create(&vec->bitmaps);
+        for (int i = 0; i < entry->count_docs; i++)
+            roaring_add(entry->bitmap, entry->docs[i], &vec->bitmaps);
+        roaring_add(entry->bitmap, doc, &vec->bitmaps);
+        entry->count_docs = (int)entry->bitmap->cardinality;
+        free(entry->docs);
+        entry->docs = NULL;
+        entry->capacity_docs = 0;
+        return;
+    }
+    if (entry->count_docs >= entry->capacity_docs) {
+        entry->capacity_docs *= 2;
+        entry->docs = realloc(entry->docs, entry->capacity_docs * sizeof(uint32_t));
+        if (entry->docs == NULL) {
+            fprintf(stderr, "Erro ao realocar memória para documentos.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    entry->docs[entry->count_docs++] = doc;
+}
+
+void vector_insert(Vector *vec, const char *word, uint32_t doc) {
+    if (vec->mphf != NULL) {
+        // Vetor congelado: as entradas estão na ordem da hash, e não na alfabética
+        WordEntry *entry = vector_search_entry(vec, word);
+        if (entry != NULL) {
+            entry->frequency++;
+            addDoc(vec, entry, doc);
+            return;
+        }
+        // Palavra nova: a hash deixa de valer e o vetor volta à ordem alfabética
+        thawVector(vec);
+    }
     int found;
     int pos = vector_binary_search(vec, word, &found);
     if (found) {
-        // A palavra já existe: atualiza a frequência e insere o novo offset
+        // A palavra já existe: atualiza a frequência e registra o documento
         WordEntry *entry = &vec->entries[pos];
         entry->frequency++;
-        if (entry->count_offsets >= entry->capacity_offsets) {
-            entry->capacity_offsets *= 2;
-            entry->offsets = realloc(entry->offsets, entry->capacity_offsets * sizeof(long));
-            if (entry->offsets == NULL) {
-                fprintf(stderr, "Erro ao realocar memória para offsets.\n");
-                exit(EXIT_FAILURE);
-            }
-        }
-        entry->offsets[entry->count_offsets++] = offset;
+        addDoc(vec, entry, doc);
     } else {
         // Se o vetor estiver cheio, aumenta sua capacidade
         if (vec->size >= vec->capacity) {
@@ -89,20 +159,28 @@ void vector_insert(Vector *vec, const char *word, long offset) {
             exit(EXIT_FAILURE);
         }
         vec->entries[pos].frequency = 1;
-        vec->entries[pos].capacity_offsets = INITIAL_OFFSET_CAPACITY;
-        vec->entries[pos].count_offsets = 0;
-        vec->entries[pos].offsets = (long *)malloc(INITIAL_OFFSET_CAPACITY * sizeof(long));
-        if (vec->entries[pos].offsets == NULL) {
-            fprintf(stderr, "Erro ao alocar memória para offsets.\n");
+        vec->entries[pos].capacity_docs = INITIAL_DOC_CAPACITY;
+        vec->entries[pos].count_docs = 0;
+        vec->entries[pos].bitmap = NULL;
+        vec->entries[pos].docs = (uint32_t *)malloc(INITIAL_DOC_CAPACITY * sizeof(uint32_t));
+        if (vec->entries[pos].docs == NULL) {
+            fprintf(stderr, "Erro ao alocar memória para documentos.\n");
             exit(EXIT_FAILURE);
         }
-        vec->entries[pos].offsets[vec->entries[pos].count_offsets++] = offset;
+        vec->entries[pos].docs[vec->entries[pos].count_docs++] = doc;
         vec->size++;
     }
 }
 
 // Procura e retorna a entrada correspondente à palavra
 WordEntry* vector_search_entry(Vector *vec, const char *word) {
+    if (vec->mphf != NULL) {
+        uint32_t h = mphf_lookup(vec->mphf, word);
+        if (h >= (uint32_t)vec->size)
+            return NULL; // MPHF_NOT_FOUND
+        WordEntry *entry = &vec->entries[h];
+        return (strcmp(entry->word, word) == 0) ? entry : NULL;
+    }
     int found;
     int pos = vector_binary_search(vec, word, &found);
     if (found)
@@ -110,3 +188,88 @@ WordEntry* vector_search_entry(Vector *vec, const char *word) {
     else
         return NULL;
 }
+
+WordEntry** vector_sorted_entries(Vector *vec) {
+    WordEntry **ordem = (WordEntry **)malloc((vec->size > 0 ? vec->size : 1) * sizeof(WordEntry *));
+    if (ordem == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a ordem das entradas.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < vec->size; i++)
+        ordem[i] = &vec->entries[i];
+    if (vec->mphf != NULL)
+        qsort(ordem, vec->size, sizeof(WordEntry *), compareEntryPtr);
+    return ordem;
+}
+
+// Aloca a estrutura da hash
+static void allocHash(Vector *vec) {
+    vec->mphf = (Mphf *)malloc(sizeof(Mphf));
+    if (vec->mphf == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a hash perfeita.\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Move cada entrada para a posição dada pela hash, que passa a ser o próprio índice da
+// entrada (sem tabela de posições). Retorna 0, sem mexer no vetor, se a hash não for
+// uma permutação das entradas (ex: gravada para outro vocabulário).
+static int placeByHash(Vector *vec) {
+    int n = vec->size > 0 ? vec->size : 1;
+    WordEntry *porHash = (WordEntry *)malloc(n * sizeof(WordEntry));
+    char *ocupada = (char *)calloc(n, 1);
+    if (porHash == NULL || ocupada == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a hash perfeita.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < vec->size; i++) {
+        uint32_t h = mphf_lookup(vec->mphf, vec->entries[i].word);
+        if (h >= (uint32_t)vec->size || ocupada[h]) {
+            free(porHash);
+            free(ocupada);
+            return 0;
+        }
+        ocupada[h] = 1;
+        porHash[h] = vec->entries[i];
+    }
+    free(ocupada);
+    free(vec->entries);
+    vec->entries = porHash;
+    vec->capacity = n;
+    return 1;
+}
+
+void vector_freeze(Vector *vec) {
+    thawVector(vec);
+    const char **words = (const char **)malloc((vec->size > 0 ? vec->size : 1) * sizeof(char *));
+    if (words == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a hash perfeita.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < vec->size; i++)
+        words[i] = vec->entries[i].word;
+    allocHash(vec);
+    mphf_build(vec->mphf, words, (uint32_t)vec->size, VECTOR_MPHF_GAMMA);
+    free(words);
+    // Duas palavras com o mesmo hash de 64 bits: mantém a busca binária
+    if (!placeByHash(vec))
+        dropHash(vec);
+}
+
+uint64_t vector_hash_bits(const Vector *vec) {
+    return (vec->mphf != NULL) ? mphf_memory_bits(vec->mphf) : 0;
+}
+
+int vector_save_hash(const Vector *vec, FILE *fp) {
+    return vec->mphf != NULL && mphf_save(vec->mphf, fp);
+}
+
+int vector_load_hash(Vector *vec, FILE *fp) {
+    thawVector(vec);
+    allocHash(vec);
+    if (!mphf_load(vec->mphf, fp) || vec->mphf->n != (uint32_t)vec->size || !placeByHash(vec)) {
+        dropHash(vec);
+        return 0;
+    }
+    return 1;
+}
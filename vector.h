@@ -4,16 +4,20 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include "pool.h"
+#include "postings.h"
 
 // Estrutura que representa uma entrada (word entry) no repositório.
-// Cada entrada contém a palavra, a contagem de ocorrências e uma lista
-// de offsets (posição no arquivo onde a linha com a citação inicia).
+// Cada entrada contém a palavra, a contagem de ocorrências e a lista dos
+// documentos (IDs das linhas com a citação, ver doc_table.h) onde ela aparece.
 typedef struct {
     char *word;          // Palavra armazenada (todas em minúsculo)
     int frequency;       // Frequência da palavra
-    long *offsets;       // Lista dinâmica de offsets
-    int count_offsets;   // Quantos offsets foram armazenados
-    int capacity_offsets;// Capacidade atual do vetor de offsets
+    uint32_t *docs;      // Lista dinâmica de documentos (NULL se estiverem em bitmap)
+    int count_docs;      // Quantos documentos distintos foram armazenados
+    int capacity_docs;   // Capacidade atual do vetor de documentos
+    Roaring *bitmap;     // Documentos compactados (palavras com POSTINGS_BITMAP_MIN ou mais)
 } WordEntry;
 
 // Estrutura que representa o vetor (array dinâmico) de entradas.
@@ -21,6 +25,9 @@ typedef struct {
     WordEntry *entries;  // Vetor dinâmico de WordEntry
     int size;            // Número de entradas atualmente armazenadas
     int capacity;        // Capacidade atual do vetor
+    struct Mphf *mphf;   // Hash perfeita mínima do vocabulário (NULL = não congelado).
+                         // Congelado, entries fica na ordem da hash, e não na alfabética.
+    Pool bitmaps;        // Memória dos bitmaps de documentos
 } Vector;
 
 // Inicializa o vetor
@@ -32,14 +39,40 @@ void freeVector(Vector *vec);
 // Função auxiliar de busca binária no vetor ordenado alfabeticamente.
 // Se a palavra for encontrada, *found é definido como 1 e retorna o índice da entrada.
 // Se não for encontrada, *found é definido como 0 e retorna o índice onde a palavra deve ser inserida.
+// Só vale com o vetor fora de congelamento (congelado, as entradas estão na ordem da hash).
 int vector_binary_search(Vector *vec, const char *word, int *found);
 
-// Insere uma ocorrência da palavra com o offset informado no vetor.
-// Se a palavra já existir, atualiza a frequência e adiciona o novo offset à lista.
+// Insere uma ocorrência da palavra no documento informado.
+// Se a palavra já existir, atualiza a frequência e adiciona o documento à lista
+// (se for diferente do último); palavras comuns passam a usar um bitmap.
 // Se não existir, insere uma nova entrada mantendo a ordem alfabética.
-void vector_insert(Vector *vec, const char *word, long offset);
+void vector_insert(Vector *vec, const char *word, uint32_t doc);
 
 // Procura uma entrada no vetor a partir da palavra e retorna o ponteiro para a entrada ou NULL se não existir.
+// Com o vetor congelado usa a hash perfeita (um hash e uma comparação); senão, a busca binária.
 WordEntry* vector_search_entry(Vector *vec, const char *word);
 
+// Congela o vocabulário: constrói uma hash perfeita mínima sobre todas as palavras e
+// move cada entrada para a posição dada pela hash. Deve ser chamada depois da carga;
+// uma nova inserção de palavra descarta a hash e volta à ordem alfabética.
+void vector_freeze(Vector *vec);
+
+// Memória ocupada pela hash perfeita em bits (0 se o vetor não estiver congelado). Não
+// há tabela de posições: o valor da hash é o índice da entrada.
+uint64_t vector_hash_bits(const Vector *vec);
+
+// Ponteiros para as entradas em ordem alfabética (o chamador libera com free). Com o
+// vetor congelado as entradas estão na ordem da hash, e a ordem é montada na hora; só
+// varreduras em ordem precisam dela.
+WordEntry** vector_sorted_entries(Vector *vec);
+
+// Grava a hash perfeita do vetor congelado em um arquivo binário aberto, para acompanhar
+// um índice persistido. Retorna 1 em caso de sucesso.
+int vector_save_hash(const Vector *vec, FILE *fp);
+
+// Lê uma hash gravada por vector_save_hash para o mesmo vocabulário, sem reconstruí-la,
+// e põe as entradas na ordem dela. Retorna 0 se o arquivo for inválido ou não
+// corresponder às palavras do vetor.
+int vector_load_hash(Vector *vec, FILE *fp);
+
 #endif // VECTOR_H
@@ -0,0 +1,10 @@
+#include "word_key.h"
+
+// Copia até KEY_PREFIX_LEN bytes da palavra e completa o restante com '\0'
+void key_make_prefix(char prefix[KEY_PREFIX_LEN], const char *word) {
+    size_t n = strlen(word);
+    if (n > KEY_PREFIX_LEN)
+        n = KEY_PREFIX_LEN;
+    memset(prefix, 0, KEY_PREFIX_LEN);
+    memcpy(prefix, word, n);
+}
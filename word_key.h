@@ -0,0 +1,29 @@
+#ifndef WORD_KEY_H
+#define WORD_KEY_H
+
+#include <string.h>
+
+// Quantidade de bytes da palavra guardados dentro do próprio nó. Palavras com menos de
+// KEY_PREFIX_LEN caracteres cabem inteiras (com o '\0'), e a comparação não sai do nó.
+#define KEY_PREFIX_LEN 12
+
+// Preenche prefix com os primeiros bytes da palavra, completando com '\0'.
+void key_make_prefix(char prefix[KEY_PREFIX_LEN], const char *word);
+
+// Indica se a palavra do nó cabe inteira no prefixo.
+static inline int key_is_inline(const char prefix[KEY_PREFIX_LEN]) {
+    return prefix[KEY_PREFIX_LEN - 1] == '\0';
+}
+
+// Compara a palavra buscada (qprefix/qword) com a chave de um nó (nprefix/nword), com o
+// mesmo resultado de strcmp(qword, palavra do nó). O prefixo resolve quase todas as
+// comparações; nword só é lido quando os prefixos empatam e a palavra não cabe no nó.
+static inline int key_compare(const char qprefix[KEY_PREFIX_LEN], const char *qword,
+                              const char nprefix[KEY_PREFIX_LEN], const char *const *nword) {
+    int cmp = memcmp(qprefix, nprefix, KEY_PREFIX_LEN);
+    if (cmp != 0 || key_is_inline(nprefix))
+        return cmp;
+    return strcmp(qword + KEY_PREFIX_LEN, *nword + KEY_PREFIX_LEN);
+}
+
+#endif // WORD_KEY_H